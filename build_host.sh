@@ -0,0 +1,32 @@
+# build the fake libEGL.so/libGLESv2.so and the benchmarks for the host into
+# ./build_host, e.g. to exercise src/segl.c on a machine without a GPU
+
+# requires Khronos EGL/GLES2 headers (EGL/eglplatform.h, EGL/eglext.h,
+# GLES2/gl2ext.h) on the host include path
+
+# optional environment:
+#     CC: host C compiler (default cc)
+#     CFLAGS: common flags to be passed to C compiler
+
+CC=${CC:-cc}
+HOST_FLAGS="-std=c11 -D_DEFAULT_SOURCE -fPIC -I./host/include -I./include/ -I./src -I./host"
+
+# clean old build artifacts
+rm -rf build_host
+mkdir -p ./build_host
+
+# build fake libraries
+$CC $CFLAGS $HOST_FLAGS -shared -o ./build_host/libGLESv2.so ./host/fake_gles2.c ./host/fake_gles2_stubs.c
+$CC $CFLAGS $HOST_FLAGS -shared -o ./build_host/libEGL.so ./host/fake_egl.c -L./build_host -lGLESv2 -Wl,-rpath,'$ORIGIN'
+
+# build benchmarks for each loader mode
+$CC $CFLAGS $HOST_FLAGS -DSEGL_FRAME_STATS -DSEGL_TRACE -o ./build_host/bench_lazy ./host/bench.c ./src/fixed_step.c ./src/frame_pacer.c ./src/frame_stats.c ./src/histogram.c ./src/hud.c ./src/scene.c ./src/segl.c ./src/segl_damage.c ./src/segl_log.c ./src/segl_scale.c ./src/segl_surface.c ./src/segl_timing.c ./src/segl_trace.c ./src/segl_upload.c -ldl -pthread -lm
+$CC $CFLAGS $HOST_FLAGS -DSEGL_FRAME_STATS -DSEGL_TRACE -DSGL_EAGER_LOAD -o ./build_host/bench_eager ./host/bench.c ./src/fixed_step.c ./src/frame_pacer.c ./src/frame_stats.c ./src/histogram.c ./src/hud.c ./src/scene.c ./src/segl.c ./src/segl_damage.c ./src/segl_log.c ./src/segl_scale.c ./src/segl_surface.c ./src/segl_timing.c ./src/segl_trace.c ./src/segl_upload.c -ldl -pthread -lm
+$CC $CFLAGS $HOST_FLAGS -DSEGL_FRAME_STATS -DSEGL_TRACE -DSEGL_DIRECT_LINK -o ./build_host/bench_direct ./host/bench.c ./src/fixed_step.c ./src/frame_pacer.c ./src/frame_stats.c ./src/histogram.c ./src/hud.c ./src/scene.c ./src/segl.c ./src/segl_damage.c ./src/segl_log.c ./src/segl_scale.c ./src/segl_surface.c ./src/segl_timing.c ./src/segl_trace.c ./src/segl_upload.c -pthread -lm -L./build_host -lEGL -lGLESv2 -Wl,-rpath,'$ORIGIN'
+
+# build the headless runner, which loads the system libEGL.so.1 by default
+$CC $CFLAGS $HOST_FLAGS -o ./build_host/headless ./host/headless.c ./src/hud.c ./src/segl.c ./src/segl_log.c ./src/scene.c -ldl -pthread -lm
+$CC $CFLAGS $HOST_FLAGS -DSEGL_ATRACE -o ./build_host/headless_atrace ./host/headless.c ./src/hud.c ./src/segl.c ./src/segl_log.c ./src/scene.c ./src/segl_trace.c -ldl -pthread -lm
+
+# build the host checks of the pure logic
+$CC $CFLAGS $HOST_FLAGS -o ./build_host/test ./host/test.c ./src/fixed_step.c ./src/frame_pacer.c ./src/histogram.c ./src/scene.c ./src/segl.c ./src/segl_damage.c ./src/segl_log.c ./src/segl_scale.c ./src/segl_surface.c -ldl -pthread -lm
@@ -0,0 +1,1050 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Host benchmark of the EGL/GL layer against the fake libEGL.so and
+// libGLESv2.so. Usage:
+//     SEGL_LIBEGL_PATH=./build_host/libEGL.so ./build_host/bench_lazy [frames]
+// SEGL_CONFIG_POLICY selects the config policy: performance (default),
+// quality or exact (RGBA8888, depth 24, stencil 8, no MSAA).
+
+#include <dlfcn.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/prctl.h>
+
+#include "fake.h"
+#include "fixed_step.h"
+#include "frame_pacer.h"
+#include "frame_stats.h"
+#include "histogram.h"
+#include "hud.h"
+#include "scene.h"
+#include "segl.h"
+#include "segl_damage.h"
+#include "segl_log.h"
+#include "segl_scale.h"
+#include "segl_surface.h"
+#include "segl_timing.h"
+#include "segl_trace.h"
+#include "segl_upload.h"
+
+#define BENCH_CALLS 10000000L
+#define BENCH_RESUMES 100L
+#define BENCH_UPLOADS 1000L
+#define BENCH_UPLOAD_HANDOVERS 4
+#define BENCH_SWAP_FRAMES 60L
+#define BENCH_DAMAGE_FRAMES 600L
+#define BENCH_DAMAGE_SPRITE 64
+#define BENCH_TIMING_FRAMES 120L
+#define BENCH_SCALE_FRAMES 300L
+#define BENCH_SCALE_TARGET_NS 16666667L
+#define BENCH_STEP_NS (16L * 1000L * 1000L)
+#define BENCH_STEP_FRAMES 240L
+#define BENCH_PACER_NS (1000L * 1000L * 1000L)
+#define BENCH_PACER_WORK_NS (4L * 1000L * 1000L)
+#define BENCH_HISTOGRAM_VALUES 100000L
+#define BENCH_STATS_FRAMES 100000L
+#define BENCH_IDLE_NS (500L * 1000L * 1000L)
+#define BENCH_IDLE_TIMESTEP_NS (16L * 1000L * 1000L)
+#define BENCH_TRACE_EVENTS 1000000L
+#define BENCH_HUD_FRAMES 10000L
+#define BENCH_LOG_MESSAGES 64L
+#define BENCH_LOG_LIMITED 1000000L
+
+#ifdef SEGL_DIRECT_LINK
+
+static const SEglVtable egl = { SEGL_EGL_PROCS(SEGL_DIRECT_X) };
+static const SGlVtable gl = { SGL_GL_PROCS(SGL_DIRECT_XR, SGL_DIRECT_XV) };
+
+#else // SEGL_DIRECT_LINK
+
+static SEglVtable egl;
+static SGlVtable gl;
+
+#endif // SEGL_DIRECT_LINK
+
+static SEglExt ext;
+
+static SEglConfigSpec bench_config_spec(void) {
+    SEglConfigSpec spec = {
+        .policy = SEGL_CONFIG_PERFORMANCE,
+        .surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+        .exact = {
+            .red = 8,
+            .green = 8,
+            .blue = 8,
+            .alpha = 8,
+            .depth = 24,
+            .stencil = 8,
+            .samples = 0,
+        },
+    };
+
+    const char *policy = getenv("SEGL_CONFIG_POLICY");
+    if (policy != NULL && strcmp(policy, "quality") == 0) {
+        spec.policy = SEGL_CONFIG_QUALITY;
+    } else if (policy != NULL && strcmp(policy, "exact") == 0) {
+        spec.policy = SEGL_CONFIG_EXACT;
+    }
+    return spec;
+}
+
+typedef uint64_t (*BenchCallCount)(const char *name);
+
+static BenchCallCount bench_call_count_load(const char *egl_path) {
+#ifdef SEGL_DIRECT_LINK
+    return fake_call_count;
+#else
+    void *so_handle = dlopen(egl_path, RTLD_LAZY | RTLD_NOLOAD);
+    if (so_handle == NULL) {
+        return NULL;
+    }
+    return (BenchCallCount)dlsym(so_handle, "fake_call_count");
+#endif
+}
+
+typedef void (*BenchLoseContext)(void);
+
+static BenchLoseContext bench_lose_context_load(const char *egl_path) {
+#ifdef SEGL_DIRECT_LINK
+    return fake_lose_context;
+#else
+    void *so_handle = dlopen(egl_path, RTLD_LAZY | RTLD_NOLOAD);
+    if (so_handle == NULL) {
+        return NULL;
+    }
+    return (BenchLoseContext)dlsym(so_handle, "fake_lose_context");
+#endif
+}
+
+static int64_t bench_now(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000L * 1000L * 1000L + now.tv_nsec;
+}
+
+// The app's frame, going through scene_draw and segl_damage_swap like
+// main.c, so each build measures the calls the app makes.
+static Scene bench_scene;
+static Scene bench_scene_prev;
+static SEglDamage bench_frame_damage;
+
+static void bench_frame_begin(void) {
+    bench_scene_prev = bench_scene;
+    scene_step(&bench_scene);
+    scene_draw(&bench_scene_prev, &bench_scene, 0.5f, &gl);
+}
+
+static void bench_frame(const SEglCtx *egl_ctx) {
+    segl_damage_invalidate(&bench_frame_damage);
+    segl_damage_begin(&bench_frame_damage, egl_ctx, &egl, &ext);
+    bench_frame_begin();
+    segl_damage_swap(&bench_frame_damage, egl_ctx, &egl, &ext);
+}
+
+static int64_t bench_cpu_now(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (int64_t)now.tv_sec * 1000L * 1000L * 1000L + now.tv_nsec;
+}
+
+static void bench_swap_mode(
+    SEglCtx *egl_ctx,
+    SEglSwapMode mode,
+    const char *name
+) {
+    segl_ctx_swap_mode(egl_ctx, &egl, mode);
+    int64_t start = bench_now();
+    int64_t cpu_start = bench_cpu_now();
+    for (long i = 0; i < BENCH_SWAP_FRAMES; i += 1) {
+        int64_t frame_start = bench_now();
+        bench_frame(egl_ctx);
+        segl_ctx_swap_adapt(
+            egl_ctx,
+            &egl,
+            bench_now() - frame_start,
+            1000000000L / 60
+        );
+    }
+    int64_t wall_ns = bench_now() - start;
+    int64_t cpu_ns = bench_cpu_now() - cpu_start;
+    printf(
+        "swap %s: %.1f fps, %lld ns CPU per frame\n",
+        name,
+        (double)BENCH_SWAP_FRAMES * 1e9 / (double)wall_ns,
+        (long long)(cpu_ns / BENCH_SWAP_FRAMES)
+    );
+}
+
+// A sprite moving over a static background: each frame damages where the
+// sprite was and where it is now.
+static void bench_damage(const SEglCtx *egl_ctx) {
+    SEglDamage damage = { 0 };
+    SEglSurfaceState surface;
+    segl_surface_init(&surface);
+    segl_surface_update(&surface, egl_ctx, &egl);
+    segl_damage_resize(&damage, surface.width, surface.height);
+    SEglRect sprite = { 0, 0, BENCH_DAMAGE_SPRITE, BENCH_DAMAGE_SPRITE };
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_DAMAGE_FRAMES; i += 1) {
+        SEglRect next = sprite;
+        next.x = (EGLint)(i * 7 % 1000);
+        next.y = (EGLint)(i * 3 % 2000);
+        segl_damage_add(&damage, sprite);
+        segl_damage_add(&damage, next);
+        sprite = next;
+
+        const SEglDamageRegion *redraw = segl_damage_begin(
+            &damage,
+            egl_ctx,
+            &egl,
+            &ext
+        );
+        if (!redraw->full) {
+            gl.Enable(GL_SCISSOR_TEST);
+        }
+        for (int r = 0; r < (redraw->full ? 1 : redraw->nrects); r += 1) {
+            if (!redraw->full) {
+                gl.Scissor(
+                    redraw->rects[r].x,
+                    redraw->rects[r].y,
+                    redraw->rects[r].width,
+                    redraw->rects[r].height
+                );
+            }
+            gl.Clear(GL_COLOR_BUFFER_BIT);
+        }
+        gl.Disable(GL_SCISSOR_TEST);
+        segl_damage_swap(&damage, egl_ctx, &egl, &ext);
+    }
+    int64_t damage_ns = bench_now() - start;
+
+    // NOTE: RGBA8888, one write per redrawn pixel
+    printf(
+        "damage: %.1f%% of pixels redrawn, %llu vs %llu bytes/frame "
+        "(%lld ns/frame)\n",
+        100.0 * (double)damage.pixels_redrawn / (double)damage.pixels_total,
+        (unsigned long long)(damage.pixels_redrawn * 4 / damage.frames),
+        (unsigned long long)(damage.pixels_total * 4 / damage.frames),
+        (long long)(damage_ns / BENCH_DAMAGE_FRAMES)
+    );
+}
+
+// Runs the scale controller over a synthetic trace: frames costing base_ns
+// at full scale, growing with the pixel count, with +-10% jitter.
+static void bench_scale_phase(
+    SEglScale *scale,
+    const char *name,
+    int64_t base_ns,
+    uint32_t *seed
+) {
+    long over = 0;
+    uint64_t changes = scale->changes;
+    for (long i = 0; i < BENCH_SCALE_FRAMES; i += 1) {
+        *seed = *seed * 1664525u + 1013904223u;
+        double jitter = 0.9 + 0.2 * (double)(*seed >> 8) / (double)(1 << 24);
+        double s = (double)scale->scale;
+        int64_t frame_ns = (int64_t)((double)base_ns * s * s * jitter);
+        over += frame_ns > BENCH_SCALE_TARGET_NS;
+        segl_scale_frame(scale, frame_ns);
+    }
+    printf(
+        "scale, %s: %.2f after %ld frames, %ld over budget, %llu changes\n",
+        name,
+        (double)scale->scale,
+        BENCH_SCALE_FRAMES,
+        over,
+        (unsigned long long)(scale->changes - changes)
+    );
+}
+
+static void bench_scale(void) {
+    SEglScale scale;
+    segl_scale_init(&scale, BENCH_SCALE_TARGET_NS, 0.5f, 1.0f);
+    uint32_t seed = 1;
+    bench_scale_phase(&scale, "light 10 ms", 10000000L, &seed);
+    bench_scale_phase(&scale, "heavy 28 ms", 28000000L, &seed);
+    bench_scale_phase(&scale, "heavy 28 ms, settled", 28000000L, &seed);
+    bench_scale_phase(&scale, "light 10 ms", 10000000L, &seed);
+    bench_scale_phase(&scale, "overload 80 ms", 80000000L, &seed);
+    segl_scale_pin(&scale, 0.75f);
+    bench_scale_phase(&scale, "pinned 0.75", 28000000L, &seed);
+}
+
+// Simulates a value moving one unit per 16 ms step, shown on a 120 Hz
+// panel, and reports how far each frame's motion strays from the steady
+// 0.52 units per frame, with and without interpolation. Then a 1 s stall.
+static void bench_fixed_step(void) {
+    const int64_t refresh_ns = 1000000000L / 120;
+    const double ideal = (double)refresh_ns / (double)BENCH_STEP_NS;
+    for (int interpolate = 0; interpolate <= 1; interpolate += 1) {
+        FixedStep step;
+        fixed_step_init(&step, BENCH_STEP_NS, 5, FIXED_STEP_CLAMP);
+        double position = 0.0;
+        double shown = 0.0;
+        double judder = 0.0;
+        for (long i = 0; i < BENCH_STEP_FRAMES; i += 1) {
+            uint64_t skipped = 0;
+            int steps = fixed_step_advance(&step, refresh_ns, &skipped);
+            position += steps;
+            double next = position - 1.0;
+            next += interpolate ? (double)fixed_step_alpha(&step) : 1.0;
+            double error = next - shown - ideal;
+            error = error < 0.0 ? -error : error;
+            judder = i > 0 && error > judder ? error : judder;
+            shown = next;
+        }
+        printf(
+            "fixed step at 120 Hz, %s: motion off by up to %.2f of %.2f "
+            "units/frame\n",
+            interpolate ? "interpolated" : "last state",
+            judder,
+            ideal
+        );
+    }
+
+    FixedStep step;
+    fixed_step_init(&step, BENCH_STEP_NS, 5, FIXED_STEP_CLAMP);
+    uint64_t skipped = 0;
+    int steps = fixed_step_advance(&step, 1000L * 1000L * 1000L, &skipped);
+    printf(
+        "fixed step after a 1 s stall: %d steps run, %lld ms dropped\n",
+        steps,
+        (long long)(step.dropped_ns / 1000000L)
+    );
+
+    // NOTE: an hour in the background, caught up step by step as the old
+    // loop did and fast-forwarded as the app does now
+    const int64_t away_ns = 3600L * 1000L * 1000L * 1000L;
+    Scene stepped;
+    scene_init(&stepped);
+    int64_t start = bench_now();
+    for (int64_t t = 0; t + BENCH_STEP_NS <= away_ns; t += BENCH_STEP_NS) {
+        scene_step(&stepped);
+    }
+    int64_t stepped_ns = bench_now() - start;
+
+    Scene forwarded;
+    scene_init(&forwarded);
+    fixed_step_init(&step, BENCH_STEP_NS, 5, FIXED_STEP_FAST_FORWARD);
+    start = bench_now();
+    steps = fixed_step_advance(&step, away_ns, &skipped);
+    scene_advance(&forwarded, skipped);
+    for (int i = 0; i < steps; i += 1) {
+        scene_step(&forwarded);
+    }
+    int64_t forwarded_ns = bench_now() - start;
+
+    float stepped_rgb[3];
+    float forwarded_rgb[3];
+    scene_color(&stepped, stepped_rgb);
+    scene_color(&forwarded, forwarded_rgb);
+    printf(
+        "resume after 1 h: %lld ns stepping, %lld ns fast-forward "
+        "(red %.3f vs %.3f)\n",
+        (long long)stepped_ns,
+        (long long)forwarded_ns,
+        (double)stepped_rgb[0],
+        (double)forwarded_rgb[0]
+    );
+}
+
+// Histogram percentiles of a skewed synthetic frame time distribution
+// against exact ones from sorting, and the cost of recording.
+static void bench_histogram(void) {
+    static int64_t values[BENCH_HISTOGRAM_VALUES];
+    static Histogram histogram;
+    histogram_reset(&histogram);
+    uint32_t seed = 7;
+    for (long i = 0; i < BENCH_HISTOGRAM_VALUES; i += 1) {
+        seed = seed * 1664525u + 1013904223u;
+        double u = (double)(seed >> 8) / (double)(1 << 24);
+        // NOTE: mostly around 4 ms with a long tail of slow frames
+        values[i] = (int64_t)(4000000.0 / (1.0 - 0.98 * u));
+    }
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_HISTOGRAM_VALUES; i += 1) {
+        histogram_record(&histogram, values[i]);
+    }
+    int64_t record_ns = bench_now() - start;
+
+    SEglPercentiles exact = segl_percentiles(values, BENCH_HISTOGRAM_VALUES);
+    printf(
+        "histogram: p50 %lld/%lld p90 %lld/%lld p99 %lld/%lld us "
+        "(bucketed/exact), %.1f ns/record\n",
+        (long long)(histogram_percentile(&histogram, 0.5) / 1000),
+        (long long)(exact.p50 / 1000),
+        (long long)(histogram_percentile(&histogram, 0.9) / 1000),
+        (long long)(exact.p90 / 1000),
+        (long long)(histogram_percentile(&histogram, 0.99) / 1000),
+        (long long)(exact.p99 / 1000),
+        (double)record_ns / (double)BENCH_HISTOGRAM_VALUES
+    );
+}
+
+// CPU side of the HUD on a 1080p surface: the stats, the layout of every
+// quad and their upload, all with the fake GL. Frames are 60 fps apart on
+// a made-up clock, so the text refreshes as often as in the app.
+static void bench_hud(void) {
+    static Hud hud;
+    hud_init(&hud, BENCH_SCALE_TARGET_NS);
+    hud_toggle(&hud);
+    const SEglRect area = { 0, 0, 1920, 1080 };
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_HUD_FRAMES; i += 1) {
+        hud_draw(&hud, &area, area.width, area.height, &gl);
+        // NOTE: every 7th frame is over the budget, for both bar colors
+        int64_t frame_ns = BENCH_SCALE_TARGET_NS * (i % 7 == 0 ? 2 : 1);
+        hud_frame(
+            &hud,
+            &(HudFrame){
+                .frame_ns = frame_ns,
+                .phase_ns = { [FRAME_PHASE_ISSUE] = frame_ns },
+            },
+            (i + 1) * BENCH_SCALE_TARGET_NS
+        );
+    }
+    int64_t hud_ns = bench_now() - start;
+    printf(
+        "hud: %lld ns/frame for %u quads in one draw call\n",
+        (long long)(hud_ns / BENCH_HUD_FRAMES),
+        hud.nvertices / 6
+    );
+}
+
+// Cost of the per-phase instrumentation of an empty frame, reports
+// included.
+static void bench_frame_stats(void) {
+    static FrameStats stats;
+    if (!frame_stats_start(&stats, BENCH_STATS_FRAMES / 4)) {
+        return;
+    }
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_STATS_FRAMES; i += 1) {
+        for (int phase = 0; phase < FRAME_PHASE_COUNT; phase += 1) {
+            frame_stats_begin(&stats, (FramePhase)phase);
+            frame_stats_end(&stats, (FramePhase)phase);
+        }
+        frame_stats_frame(&stats);
+    }
+    int64_t stats_ns = bench_now() - start;
+    frame_stats_stop(&stats);
+    printf(
+        "frame stats: %lld ns/frame for %d phases, %llu reports dropped\n",
+        (long long)(stats_ns / BENCH_STATS_FRAMES),
+        FRAME_PHASE_COUNT,
+        (unsigned long long)stats.dropped
+    );
+}
+
+static atomic_bool bench_tracer_quit;
+
+static void *bench_tracer(void *userdata) {
+    prctl(PR_SET_NAME, "bench_tracer", 0, 0, 0);
+    while (!atomic_load(&bench_tracer_quit)) {
+        SEGL_TRACE_BEGIN("tracer");
+        SEGL_TRACE_END("tracer");
+    }
+    return NULL;
+}
+
+static void *bench_tracer_once(void *userdata) {
+    prctl(PR_SET_NAME, "bench_restart", 0, 0, 0);
+    SEGL_TRACE_INSTANT("restart");
+    return NULL;
+}
+
+// Records begin/end pairs on this thread, restarts a thread more times
+// than there are rings, then dumps everything traced so far while another
+// thread keeps recording into its ring.
+static void bench_trace(const char *path) {
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_TRACE_EVENTS / 2; i += 1) {
+        SEGL_TRACE_BEGIN("bench_trace");
+        SEGL_TRACE_END("bench_trace");
+    }
+    int64_t event_ns = bench_now() - start;
+
+    // NOTE: each restart takes over the ring of the one before, so none
+    // of them is dropped
+    for (int i = 0; i < 2 * SEGL_TRACE_MAX_THREADS; i += 1) {
+        pthread_t restarted;
+        if (pthread_create(&restarted, NULL, bench_tracer_once, NULL) != 0) {
+            return;
+        }
+        pthread_join(restarted, NULL);
+    }
+
+    pthread_t tracer;
+    atomic_store(&bench_tracer_quit, false);
+    if (pthread_create(&tracer, NULL, bench_tracer, NULL) != 0) {
+        return;
+    }
+    // NOTE: let the tracer wrap its ring so the dump races its writes
+    usleep(10000);
+    start = bench_now();
+    bool dumped = segl_trace_dump(path);
+    int64_t dump_ns = bench_now() - start;
+    atomic_store(&bench_tracer_quit, true);
+    pthread_join(tracer, NULL);
+    printf(
+        "trace: %lld ns/event, dump %s in %lld us\n",
+        (long long)(event_ns / BENCH_TRACE_EVENTS),
+        dumped ? path : "failed",
+        (long long)(dump_ns / 1000)
+    );
+}
+
+// Logs a burst that fits in the ring through the drain thread, the same
+// burst written synchronously, then one call site far over its rate
+// limit. All of it goes to stderr.
+static void bench_log(void) {
+    int64_t start = bench_now();
+    for (long i = 0; i < BENCH_LOG_MESSAGES; i += 1) {
+        segl_log_print(
+            NULL,
+            ANDROID_LOG_DEBUG,
+            SEGL_ANDROID_LOG_ID,
+            "bench_log queued %ld",
+            i
+        );
+    }
+    int64_t queued_ns = bench_now() - start;
+    segl_log_flush();
+
+    start = bench_now();
+    for (long i = 0; i < BENCH_LOG_MESSAGES; i += 1) {
+        __android_log_print(
+            ANDROID_LOG_DEBUG,
+            SEGL_ANDROID_LOG_ID,
+            "bench_log synchronous %ld",
+            i
+        );
+    }
+    int64_t sync_ns = bench_now() - start;
+
+    start = bench_now();
+    for (long i = 0; i < BENCH_LOG_LIMITED; i += 1) {
+        SEGL_LOG(ANDROID_LOG_DEBUG, "bench_log limited %ld", i);
+    }
+    int64_t limited_ns = bench_now() - start;
+    segl_log_flush();
+    printf(
+        "log: %lld ns/message queued, %lld ns synchronous, "
+        "%lld ns rate limited, %llu dropped\n",
+        (long long)(queued_ns / BENCH_LOG_MESSAGES),
+        (long long)(sync_ns / BENCH_LOG_MESSAGES),
+        (long long)(limited_ns / BENCH_LOG_LIMITED),
+        (unsigned long long)segl_log_dropped()
+    );
+}
+
+// Paces frames for a second from a timerfd standing in for AChoreographer
+// at 60 Hz. Frames take 4 ms of work, every 20th one 40 ms, which misses
+// the deadline at 60 and 30 fps; frame starts should stay on the vsync grid.
+static void bench_pacer(int divisor) {
+    FrameTimer timer;
+    if (!frame_timer_open(&timer, 1000000000L / 60)) {
+        perror("timerfd_create");
+        return;
+    }
+    FramePacer pacer;
+    frame_pacer_init(&pacer, timer.period_ns, divisor);
+    frame_timer_arm(&timer, true);
+
+    struct pollfd pollfd = { .fd = timer.fd, .events = POLLIN };
+    int64_t start = bench_now();
+    int64_t last_start_ns = 0;
+    int64_t max_error_ns = 0;
+    while (bench_now() - start < BENCH_PACER_NS) {
+        poll(&pollfd, 1, -1);
+        int64_t vsync_ns = frame_timer_read(&timer);
+        if (vsync_ns == 0 || !frame_pacer_vsync(&pacer, vsync_ns)) {
+            continue;
+        }
+        // NOTE: a started frame should be whole refreshes after the last
+        if (last_start_ns != 0) {
+            int64_t gap_ns = vsync_ns - last_start_ns;
+            int64_t error_ns = gap_ns % timer.period_ns;
+            if (error_ns > timer.period_ns / 2) {
+                error_ns = timer.period_ns - error_ns;
+            }
+            max_error_ns = error_ns > max_error_ns ? error_ns : max_error_ns;
+        }
+        last_start_ns = vsync_ns;
+
+        int64_t work_ns = BENCH_PACER_WORK_NS;
+        if (pacer.frames % 20 == 19) {
+            work_ns *= 10;
+        }
+        const struct timespec work = { .tv_nsec = work_ns };
+        nanosleep(&work, NULL);
+        frame_pacer_frame_done(&pacer, bench_now());
+    }
+    int64_t elapsed_ns = bench_now() - start;
+    frame_timer_close(&timer);
+
+    printf(
+        "pacer, every %d vsync: %.1f fps, %llu missed deadlines, "
+        "%llu vsyncs skipped, starts off the vsync grid by %lld ns\n",
+        divisor,
+        (double)pacer.frames * 1e9 / (double)elapsed_ns,
+        (unsigned long long)pacer.missed,
+        (unsigned long long)pacer.skipped,
+        (long long)max_error_ns
+    );
+}
+
+typedef struct {
+    int fd;
+    int64_t sent_ns;
+} BenchCommand;
+
+static void *bench_command_thread(void *userdata) {
+    BenchCommand *command = userdata;
+    const struct timespec delay = {
+        .tv_sec = BENCH_IDLE_NS / 1000000000L,
+        .tv_nsec = BENCH_IDLE_NS % 1000000000L,
+    };
+    nanosleep(&delay, NULL);
+    __atomic_store_n(&command->sent_ns, bench_now(), __ATOMIC_RELEASE);
+    char cmd = 1;
+    if (write(command->fd, &cmd, 1) != 1) {
+        perror("write");
+    }
+    return NULL;
+}
+
+// Stands in for the app with no surface waiting for its next command: a
+// pipe plays the looper's command fd, as ALooper is built on epoll. The
+// old loop polled without blocking and slept a timestep; blocking on the
+// fd costs no CPU and wakes as soon as the command is written.
+static void bench_idle(bool block) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return;
+    }
+    BenchCommand command = { .fd = fds[1] };
+    pthread_t thread;
+    pthread_create(&thread, NULL, bench_command_thread, &command);
+
+    struct pollfd pollfd = { .fd = fds[0], .events = POLLIN };
+    const struct timespec timestep = { .tv_nsec = BENCH_IDLE_TIMESTEP_NS };
+    long wakeups = 0;
+    int64_t cpu_start = bench_cpu_now();
+    for (;;) {
+        wakeups += 1;
+        if (poll(&pollfd, 1, block ? -1 : 0) > 0) {
+            break;
+        }
+        nanosleep(&timestep, NULL);
+    }
+    int64_t woke_ns = bench_now();
+    int64_t cpu_ns = bench_cpu_now() - cpu_start;
+    pthread_join(thread, NULL);
+    close(fds[0]);
+    close(fds[1]);
+
+    printf(
+        "idle, %s: %lld ns CPU over %ld ms, %ld wakeups, "
+        "%lld ns command latency\n",
+        block ? "blocking" : "polling",
+        (long long)cpu_ns,
+        BENCH_IDLE_NS / 1000000L,
+        wakeups,
+        (long long)(
+            woke_ns - __atomic_load_n(&command.sent_ns, __ATOMIC_ACQUIRE)
+        )
+    );
+}
+
+static void bench_percentiles(const char *name, SEglPercentiles p) {
+    printf(
+        "%s: p50 %lld p90 %lld p99 %lld max %lld us\n",
+        name,
+        (long long)(p.p50 / 1000),
+        (long long)(p.p90 / 1000),
+        (long long)(p.p99 / 1000),
+        (long long)(p.max / 1000)
+    );
+}
+
+// Frames on the fake's display timeline, every other one paced through
+// eglPresentationTimeANDROID two refreshes ahead.
+static void bench_timing(const SEglCtx *egl_ctx) {
+    static SEglTiming timing;
+    if (!segl_timing_start(&timing, egl_ctx, &egl, &ext)) {
+        printf("frame timing: unsupported\n");
+        return;
+    }
+    for (long i = 0; i < BENCH_TIMING_FRAMES; i += 1) {
+        int64_t present_ns = i % 2 == 0 ? bench_now() + 2 * 16666667L : 0;
+        bench_frame_begin();
+        segl_timing_frame(&timing, egl_ctx, &ext, present_ns);
+        egl.SwapBuffers(egl_ctx->display, egl_ctx->surface);
+        segl_timing_poll(&timing, egl_ctx, &ext);
+    }
+
+    // NOTE: the last frames reach the fake display up to two refreshes late
+    const struct timespec settle = { .tv_nsec = 100L * 1000L * 1000L };
+    nanosleep(&settle, NULL);
+    segl_timing_poll(&timing, egl_ctx, &ext);
+
+    SEglTimingReport report;
+    segl_timing_report(&timing, &report);
+    printf("frame timing: %zu frames resolved\n", report.frames);
+    bench_percentiles("  swap to present", report.swap_to_present);
+    bench_percentiles("  swap to gpu complete", report.swap_to_gpu_complete);
+    bench_percentiles("  latch to present", report.latch_to_present);
+    bench_percentiles("  present error", report.present_error);
+}
+
+static void bench_upload(const SGlVtable *sgl_vtable, void *userdata) {
+    static uint32_t texels[64 * 64];
+    sgl_vtable->TexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        64,
+        64,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        texels
+    );
+}
+
+static void bench_upload_done(void *userdata) {
+    *(long *)userdata += 1;
+}
+
+static void bench_restore(SEglLoss loss, void *userdata) {
+    *(long *)userdata += 1;
+}
+
+// Loses the surface or the whole context before a swap, as a driver
+// reset would, and times segl_ctx_recover bringing the next frame back.
+static void bench_recover(
+    SEglCtx *egl_ctx,
+    const SEglConfigSpec *spec,
+    BenchLoseContext lose_context
+) {
+    static const char *const names[] = {
+        [SEGL_LOSS_SURFACE] = "surface",
+        [SEGL_LOSS_CONTEXT] = "context",
+    };
+    static const SEglLoss losses[] = { SEGL_LOSS_SURFACE, SEGL_LOSS_CONTEXT };
+    for (size_t l = 0; l < countof(losses); l += 1) {
+        SEglLoss loss = losses[l];
+        SEglRecovery recovery = { 0 };
+        long restored = 0;
+        segl_recovery_register(&recovery, NULL, bench_restore, &restored);
+
+        int64_t total_ns = 0;
+        for (long i = 0; i < BENCH_RESUMES; i += 1) {
+            if (loss == SEGL_LOSS_CONTEXT) {
+                lose_context();
+            } else {
+                egl.DestroySurface(egl_ctx->display, egl_ctx->surface);
+            }
+            bench_frame_begin();
+            SEglLoss seen = segl_loss_check(
+                egl.SwapBuffers(egl_ctx->display, egl_ctx->surface),
+                &egl
+            );
+            segl_ctx_recover(
+                egl_ctx,
+                &recovery,
+                seen,
+                (EGLNativeWindowType)1,
+                &egl,
+                spec
+            );
+            total_ns += recovery.last_ns;
+            bench_frame(egl_ctx);
+        }
+        printf(
+            "%s loss recovery: %lld ns avg, %lld ns max "
+            "(%u recoveries, %ld restores)\n",
+            names[loss],
+            (long long)(total_ns / BENCH_RESUMES),
+            (long long)recovery.max_ns,
+            recovery.recoveries,
+            restored
+        );
+
+        // NOTE: the fake refuses window 0, so the first rebuild fails and
+        // must leave the loss pending for the retry instead of exiting
+        if (loss == SEGL_LOSS_CONTEXT) {
+            lose_context();
+        } else {
+            egl.DestroySurface(egl_ctx->display, egl_ctx->surface);
+        }
+        SEglLoss seen = segl_loss_check(
+            egl.SwapBuffers(egl_ctx->display, egl_ctx->surface),
+            &egl
+        );
+        bool failed = !segl_ctx_recover(
+            egl_ctx,
+            &recovery,
+            seen,
+            (EGLNativeWindowType)0,
+            &egl,
+            spec
+        );
+        SEglLoss pending = recovery.pending;
+        bool retried = segl_ctx_recover(
+            egl_ctx,
+            &recovery,
+            SEGL_LOSS_NONE,
+            (EGLNativeWindowType)1,
+            &egl,
+            spec
+        );
+        bench_frame(egl_ctx);
+        printf(
+            "%s loss retry after a failed rebuild: %s\n",
+            names[loss],
+            failed && pending == loss && retried ? "ok" : "FAIL"
+        );
+    }
+}
+
+int main(int argc, char **argv) {
+    long frames = argc > 1 ? atol(argv[1]) : 1000;
+    segl_log_start();
+    const char *egl_path = getenv("SEGL_LIBEGL_PATH");
+    if (egl_path == NULL) {
+        egl_path = SEGL_LIBEGL_NAME;
+    }
+
+#if defined(SEGL_DIRECT_LINK)
+    printf("mode: direct\n");
+#elif defined(SGL_EAGER_LOAD)
+    printf("mode: eager\n");
+#else
+    printf("mode: lazy\n");
+#endif
+
+#ifndef SEGL_DIRECT_LINK
+    SProcStats egl_stats;
+    egl = segl_vtable_load(egl_path, &egl_stats);
+    printf(
+        "egl_vtable_load: %lld ns (%u loaded)\n",
+        (long long)egl_stats.load_ns,
+        egl_stats.loaded
+    );
+
+    SProcStats gl_stats;
+    sgl_vtable_load(&gl, &egl, &gl_stats);
+    printf(
+        "gl_vtable_load: %lld ns (%u loaded)\n",
+        (long long)gl_stats.load_ns,
+        gl_stats.loaded
+    );
+#endif // SEGL_DIRECT_LINK
+
+    const char *cache_path = getenv("SEGL_CACHE_PATH");
+    if (cache_path == NULL) {
+        cache_path = "/tmp/segl_cache.bin";
+    }
+    remove(cache_path);
+
+    // NOTE: cold start first, then a warm start from the cache it wrote
+    SEglConfigSpec config_spec = bench_config_spec();
+    SEglCache cache;
+    int64_t start = bench_now();
+    if (segl_cache_read(&cache, cache_path)) {
+        config_spec.cache = &cache;
+    }
+    SEglCtx egl_ctx = segl_ctx_load(
+        (EGLNativeWindowType)1,
+        &egl,
+        &config_spec
+    );
+    int64_t ctx_ns = bench_now() - start;
+    segl_ext_load(&ext, &egl, &gl, egl_ctx.display, config_spec.cache);
+    int64_t cold_ns = bench_now() - start;
+    printf(
+        "startup, no cache: %lld ns (segl_ctx_load %lld ns)\n",
+        (long long)cold_ns,
+        (long long)ctx_ns
+    );
+
+    segl_cache_fill(&cache, &egl, &gl, &egl_ctx, &config_spec, &ext);
+    if (!segl_cache_write(&cache, cache_path)) {
+        fprintf(stderr, "failed to write %s\n", cache_path);
+        return 1;
+    }
+    segl_ctx_unload(&egl_ctx, &egl);
+
+    start = bench_now();
+    if (segl_cache_read(&cache, cache_path)) {
+        config_spec.cache = &cache;
+    }
+    egl_ctx = segl_ctx_load((EGLNativeWindowType)1, &egl, &config_spec);
+    ctx_ns = bench_now() - start;
+    segl_ext_load(&ext, &egl, &gl, egl_ctx.display, config_spec.cache);
+    int64_t warm_ns = bench_now() - start;
+    printf(
+        "startup, cached: %lld ns (segl_ctx_load %lld ns, config %s, "
+        "caps %s)\n",
+        (long long)warm_ns,
+        (long long)ctx_ns,
+        egl_ctx.config_cached ? "hit" : "miss",
+        ext.caps_cached ? "hit" : "miss"
+    );
+
+    scene_init(&bench_scene);
+    SEglSurfaceState surface;
+    segl_surface_init(&surface);
+    segl_surface_update(&surface, &egl_ctx, &egl);
+    segl_damage_resize(&bench_frame_damage, surface.width, surface.height);
+
+    start = bench_now();
+    for (long i = 0; i < frames; i += 1) {
+        bench_frame(&egl_ctx);
+    }
+    int64_t frame_ns = bench_now() - start;
+    printf(
+        "frames: %ld in %lld ns (%lld ns/frame)\n",
+        frames,
+        (long long)frame_ns,
+        (long long)(frames > 0 ? frame_ns / frames : 0)
+    );
+
+    start = bench_now();
+    for (long i = 0; i < BENCH_CALLS; i += 1) {
+        gl.Disable(GL_DITHER);
+    }
+    int64_t call_ns = bench_now() - start;
+    printf(
+        "gl call overhead: %.2f ns/call\n",
+        (double)call_ns / (double)BENCH_CALLS
+    );
+
+    // NOTE: only paced when the fake simulates a display, see
+    // FAKE_EGL_REFRESH_HZ
+    bench_swap_mode(&egl_ctx, SEGL_SWAP_UNTHROTTLED, "unthrottled");
+    bench_swap_mode(&egl_ctx, SEGL_SWAP_VSYNC, "vsync");
+    bench_swap_mode(&egl_ctx, SEGL_SWAP_HALF_RATE, "half rate");
+    bench_swap_mode(&egl_ctx, SEGL_SWAP_ADAPTIVE, "adaptive");
+    segl_ctx_swap_mode(&egl_ctx, &egl, SEGL_SWAP_UNTHROTTLED);
+
+    bench_damage(&egl_ctx);
+    bench_timing(&egl_ctx);
+    bench_scale();
+    bench_fixed_step();
+    bench_histogram();
+    bench_frame_stats();
+    bench_hud();
+    bench_pacer(1);
+    bench_pacer(2);
+    bench_pacer(3);
+    bench_idle(false);
+    bench_idle(true);
+
+    // NOTE: the render thread keeps drawing frames while uploads complete
+    SEglUploader uploader;
+    if (segl_upload_start(&uploader, &egl_ctx, &egl, &gl, &ext)) {
+        long submitted = 0;
+        long handed = 0;
+        long upload_frames = 0;
+        start = bench_now();
+        while (handed < BENCH_UPLOADS) {
+            while (
+                submitted < BENCH_UPLOADS &&
+                segl_upload_submit(
+                    &uploader,
+                    bench_upload,
+                    bench_upload_done,
+                    &handed
+                )
+            ) {
+                submitted += 1;
+            }
+            bench_frame(&egl_ctx);
+            segl_upload_poll(&uploader, BENCH_UPLOAD_HANDOVERS);
+            upload_frames += 1;
+        }
+        int64_t upload_ns = bench_now() - start;
+        segl_upload_stop(&uploader);
+        printf(
+            "uploads: %ld over %ld frames in %lld ns (%d per frame cap)\n",
+            handed,
+            upload_frames,
+            (long long)upload_ns,
+            BENCH_UPLOAD_HANDOVERS
+        );
+    }
+
+    // NOTE: a resume is a TERM_WINDOW/INIT_WINDOW round trip plus one frame
+    start = bench_now();
+    for (long i = 0; i < BENCH_RESUMES; i += 1) {
+        segl_ctx_surface_unload(&egl_ctx, &egl);
+        segl_ctx_surface_load(&egl_ctx, (EGLNativeWindowType)1, &egl);
+        bench_frame(&egl_ctx);
+    }
+    printf(
+        "resume to first frame, surface only: %lld ns\n",
+        (long long)((bench_now() - start) / BENCH_RESUMES)
+    );
+
+    start = bench_now();
+    for (long i = 0; i < BENCH_RESUMES; i += 1) {
+        segl_ctx_unload(&egl_ctx, &egl);
+        egl_ctx = segl_ctx_load((EGLNativeWindowType)1, &egl, &config_spec);
+        bench_frame(&egl_ctx);
+    }
+    printf(
+        "resume to first frame, full context: %lld ns\n",
+        (long long)((bench_now() - start) / BENCH_RESUMES)
+    );
+
+    BenchLoseContext lose_context = bench_lose_context_load(egl_path);
+    if (lose_context != NULL) {
+        bench_recover(&egl_ctx, &config_spec, lose_context);
+    }
+
+    const char *trace_path = getenv("SEGL_TRACE_PATH");
+    if (trace_path == NULL) {
+        trace_path = "/tmp/segl_trace.json";
+    }
+    bench_trace(trace_path);
+    bench_log();
+
+    start = bench_now();
+    segl_ctx_unload(&egl_ctx, &egl);
+    printf("segl_ctx_unload: %lld ns\n", (long long)(bench_now() - start));
+
+    BenchCallCount call_count = bench_call_count_load(egl_path);
+    if (call_count != NULL) {
+        printf(
+            "calls: eglGetProcAddress=%llu eglSwapBuffers=%llu glClear=%llu\n",
+            (unsigned long long)call_count("eglGetProcAddress"),
+            (unsigned long long)call_count("eglSwapBuffers"),
+            (unsigned long long)call_count("glClear")
+        );
+    }
+
+    segl_log_flush();
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Call accounting shared by the fake libEGL.so and libGLESv2.so. The fakes
+// count every call and can sleep for a configured latency per function:
+//     FAKE_EGL_LATENCY_US="eglSwapBuffers=16000,eglChooseConfig=2000"
+// Setting FAKE_EGL_REPORT prints all non-zero call counts at exit.
+
+#ifndef SEGL_FAKE_H
+#define SEGL_FAKE_H
+
+#include <stdint.h>
+
+#include "segl.h"
+
+enum {
+#define X(type, name, required) FAKE_egl##name,
+    SEGL_EGL_PROCS(X)
+#undef X
+#define X(type, prefix, name, ext_id) FAKE_##prefix##name,
+    SEGL_EXT_PROCS(X)
+#undef X
+#define XR(type, ret, name, params, args) FAKE_gl##name,
+#define XV(type, name, params, args) FAKE_gl##name,
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+    FAKE_PROC_COUNT,
+};
+
+extern const char *const fake_proc_names[FAKE_PROC_COUNT];
+
+void fake_call(int id);
+uint64_t fake_call_count(const char *name);
+void fake_set_latency(const char *name, int64_t latency_ns);
+void fake_reset(void);
+// Loses every live context, like a GPU reset: eglMakeCurrent and
+// eglSwapBuffers fail with EGL_CONTEXT_LOST until they are recreated.
+void fake_lose_context(void);
+
+#endif // SEGL_FAKE_H
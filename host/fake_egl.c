@@ -0,0 +1,919 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Fake libEGL.so for running the EGL/GL layer on a host without a GPU. It
+// reports a fixed set of configs, hands out opaque handles and resolves
+// eglGetProcAddress against the fake libGLESv2.so. Environment:
+//     FAKE_EGL_EXTENSIONS: overrides the EGL_EXTENSIONS string
+//     FAKE_EGL_SURFACE_SIZE: window surface size as WxH (default 1080x2400)
+//     FAKE_EGL_REFRESH_HZ: simulated display refresh rate; when set,
+//         eglSwapBuffers blocks for vsync according to eglSwapInterval
+// Frame timestamps follow a simple pipeline: the GPU finishes a quarter
+// refresh after the swap, the compositor latches at the next vsync and
+// the frame shows one refresh later (60 Hz unless FAKE_EGL_REFRESH_HZ).
+// See fake.h for call counting, artificial latency and context loss.
+
+#define EGL_EGLEXT_PROTOTYPES 1
+#define GL_GLEXT_PROTOTYPES 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fake.h"
+
+#define FAKE_BUFFER_COUNT 3
+#define FAKE_TIMESTAMP_LEN 64
+
+typedef struct {
+    EGLint red;
+    EGLint green;
+    EGLint blue;
+    EGLint alpha;
+    EGLint depth;
+    EGLint stencil;
+    EGLint samples;
+    EGLint surface_type;
+} FakeConfig;
+
+// NOTE: roughly what a mid-range Android GPU driver reports
+static const FakeConfig fake_configs[] = {
+    { 5, 6, 5, 0, 0, 0, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 5, 6, 5, 0, 24, 8, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 0, 0, 0, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 8, 0, 0, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 8, 16, 0, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 8, 24, 8, 0, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 8, 24, 8, 4, EGL_WINDOW_BIT | EGL_PBUFFER_BIT },
+    { 8, 8, 8, 8, 24, 8, 4, EGL_PBUFFER_BIT },
+    { 10, 10, 10, 2, 0, 0, 0, EGL_WINDOW_BIT },
+};
+
+typedef struct {
+    bool used;
+    EGLint width;
+    EGLint height;
+    uint64_t swaps;
+    EGLint swap_interval;
+    int64_t last_vsync_ns;
+    bool timestamps;
+    EGLnsecsANDROID next_requested_ns;
+    int64_t swap_ns[FAKE_TIMESTAMP_LEN];
+    EGLnsecsANDROID requested_ns[FAKE_TIMESTAMP_LEN];
+} FakeSurface;
+
+static int fake_display;
+static bool fake_initialized;
+static FakeSurface fake_surfaces[16];
+static int fake_contexts[16];
+static bool fake_contexts_used[16];
+static bool fake_contexts_lost[16];
+// NOTE: like real EGL, the current context and error are per thread
+static _Thread_local EGLSurface fake_current_surface = EGL_NO_SURFACE;
+static _Thread_local EGLContext fake_current_context = EGL_NO_CONTEXT;
+static _Thread_local EGLint fake_error = EGL_SUCCESS;
+static int fake_syncs[16];
+
+static bool fake_display_valid(EGLDisplay dpy) {
+    if (dpy != (EGLDisplay)&fake_display) {
+        fake_error = EGL_BAD_DISPLAY;
+        return false;
+    }
+    if (!fake_initialized) {
+        fake_error = EGL_NOT_INITIALIZED;
+        return false;
+    }
+    return true;
+}
+
+static const FakeConfig *fake_config(EGLConfig config) {
+    const FakeConfig *fake = config;
+    if (fake < fake_configs || fake >= fake_configs + countof(fake_configs)) {
+        fake_error = EGL_BAD_CONFIG;
+        return NULL;
+    }
+    return fake;
+}
+
+static bool fake_context_lost(EGLContext ctx) {
+    int *fake = ctx;
+    return (
+        fake >= fake_contexts &&
+        fake < fake_contexts + countof(fake_contexts) &&
+        fake_contexts_lost[fake - fake_contexts]
+    );
+}
+
+void fake_lose_context(void) {
+    for (size_t i = 0; i < countof(fake_contexts); i += 1) {
+        fake_contexts_lost[i] = fake_contexts_used[i];
+    }
+}
+
+static FakeSurface *fake_surface(EGLSurface surface) {
+    FakeSurface *fake = surface;
+    if (
+        fake < fake_surfaces ||
+        fake >= fake_surfaces + countof(fake_surfaces) ||
+        !fake->used
+    ) {
+        fake_error = EGL_BAD_SURFACE;
+        return NULL;
+    }
+    return fake;
+}
+
+static EGLSurface fake_surface_create(EGLint width, EGLint height) {
+    for (size_t i = 0; i < countof(fake_surfaces); i += 1) {
+        if (!fake_surfaces[i].used) {
+            fake_surfaces[i] = (FakeSurface){
+                .used = true,
+                .width = width,
+                .height = height,
+                .swap_interval = 1,
+                .next_requested_ns = EGL_TIMESTAMP_INVALID_ANDROID,
+            };
+            return &fake_surfaces[i];
+        }
+    }
+    fake_error = EGL_BAD_ALLOC;
+    return EGL_NO_SURFACE;
+}
+
+static EGLint fake_config_attrib(const FakeConfig *config, EGLint attribute) {
+    switch (attribute) {
+        case EGL_RED_SIZE:
+            return config->red;
+        case EGL_GREEN_SIZE:
+            return config->green;
+        case EGL_BLUE_SIZE:
+            return config->blue;
+        case EGL_ALPHA_SIZE:
+            return config->alpha;
+        case EGL_BUFFER_SIZE:
+            return config->red + config->green + config->blue + config->alpha;
+        case EGL_DEPTH_SIZE:
+            return config->depth;
+        case EGL_STENCIL_SIZE:
+            return config->stencil;
+        case EGL_SAMPLES:
+            return config->samples;
+        case EGL_SAMPLE_BUFFERS:
+            return config->samples > 0;
+        case EGL_SURFACE_TYPE:
+            return config->surface_type;
+        case EGL_RENDERABLE_TYPE:
+        case EGL_CONFORMANT:
+            return EGL_OPENGL_ES2_BIT;
+        case EGL_COLOR_BUFFER_TYPE:
+            return EGL_RGB_BUFFER;
+        case EGL_CONFIG_ID:
+            return (EGLint)(config - fake_configs) + 1;
+        case EGL_CONFIG_CAVEAT:
+            return EGL_NONE;
+        case EGL_NATIVE_VISUAL_ID:
+            return config->red == 5 ? 4 : 1;
+        case EGL_MIN_SWAP_INTERVAL:
+            return 0;
+        case EGL_MAX_SWAP_INTERVAL:
+            return 4;
+        case EGL_MAX_PBUFFER_WIDTH:
+        case EGL_MAX_PBUFFER_HEIGHT:
+            return 4096;
+        default:
+            return 0;
+    }
+}
+
+static bool fake_config_matches(
+    const FakeConfig *config,
+    const EGLint *attrib_list
+) {
+    for (const EGLint *attrib = attrib_list; *attrib != EGL_NONE; attrib += 2) {
+        EGLint want = attrib[1];
+        EGLint have = fake_config_attrib(config, attrib[0]);
+        if (want == EGL_DONT_CARE) {
+            continue;
+        }
+        switch (attrib[0]) {
+            case EGL_SURFACE_TYPE:
+            case EGL_RENDERABLE_TYPE:
+            case EGL_CONFORMANT:
+                if ((have & want) != want) {
+                    return false;
+                }
+                break;
+            case EGL_COLOR_BUFFER_TYPE:
+            case EGL_CONFIG_ID:
+            case EGL_NATIVE_VISUAL_ID:
+                if (have != want) {
+                    return false;
+                }
+                break;
+            default:
+                if (have < want) {
+                    return false;
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglChooseConfig(
+    EGLDisplay dpy,
+    const EGLint *attrib_list,
+    EGLConfig *configs,
+    EGLint config_size,
+    EGLint *num_config
+) {
+    fake_call(FAKE_eglChooseConfig);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+
+    EGLint n = 0;
+    for (size_t i = 0; i < countof(fake_configs); i += 1) {
+        if (
+            attrib_list != NULL &&
+            !fake_config_matches(&fake_configs[i], attrib_list)
+        ) {
+            continue;
+        }
+        if (configs != NULL && n < config_size) {
+            configs[n] = (EGLConfig)&fake_configs[i];
+        }
+        n += 1;
+    }
+    *num_config = configs != NULL && n > config_size ? config_size : n;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglCopyBuffers(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLNativePixmapType target
+) {
+    fake_call(FAKE_eglCopyBuffers);
+    return fake_display_valid(dpy) && fake_surface(surface) != NULL;
+}
+
+EGLAPI EGLContext EGLAPIENTRY eglCreateContext(
+    EGLDisplay dpy,
+    EGLConfig config,
+    EGLContext share_context,
+    const EGLint *attrib_list
+) {
+    fake_call(FAKE_eglCreateContext);
+    if (!fake_display_valid(dpy) || fake_config(config) == NULL) {
+        return EGL_NO_CONTEXT;
+    }
+    for (size_t i = 0; i < countof(fake_contexts); i += 1) {
+        if (!fake_contexts_used[i]) {
+            fake_contexts_used[i] = true;
+            fake_contexts_lost[i] = false;
+            return &fake_contexts[i];
+        }
+    }
+    fake_error = EGL_BAD_ALLOC;
+    return EGL_NO_CONTEXT;
+}
+
+EGLAPI EGLSurface EGLAPIENTRY eglCreatePbufferSurface(
+    EGLDisplay dpy,
+    EGLConfig config,
+    const EGLint *attrib_list
+) {
+    fake_call(FAKE_eglCreatePbufferSurface);
+    if (!fake_display_valid(dpy) || fake_config(config) == NULL) {
+        return EGL_NO_SURFACE;
+    }
+    EGLint width = 0;
+    EGLint height = 0;
+    for (
+        const EGLint *attrib = attrib_list;
+        attrib != NULL && *attrib != EGL_NONE;
+        attrib += 2
+    ) {
+        if (attrib[0] == EGL_WIDTH) {
+            width = attrib[1];
+        } else if (attrib[0] == EGL_HEIGHT) {
+            height = attrib[1];
+        }
+    }
+    return fake_surface_create(width, height);
+}
+
+EGLAPI EGLSurface EGLAPIENTRY eglCreatePixmapSurface(
+    EGLDisplay dpy,
+    EGLConfig config,
+    EGLNativePixmapType pixmap,
+    const EGLint *attrib_list
+) {
+    fake_call(FAKE_eglCreatePixmapSurface);
+    fake_error = EGL_BAD_NATIVE_PIXMAP;
+    return EGL_NO_SURFACE;
+}
+
+EGLAPI EGLSurface EGLAPIENTRY eglCreateWindowSurface(
+    EGLDisplay dpy,
+    EGLConfig config,
+    EGLNativeWindowType win,
+    const EGLint *attrib_list
+) {
+    fake_call(FAKE_eglCreateWindowSurface);
+    if (!fake_display_valid(dpy) || fake_config(config) == NULL) {
+        return EGL_NO_SURFACE;
+    }
+    if (win == 0) {
+        fake_error = EGL_BAD_NATIVE_WINDOW;
+        return EGL_NO_SURFACE;
+    }
+    int width = 1080;
+    int height = 2400;
+    const char *size = getenv("FAKE_EGL_SURFACE_SIZE");
+    if (size != NULL) {
+        sscanf(size, "%dx%d", &width, &height);
+    }
+    return fake_surface_create(width, height);
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglDestroyContext(
+    EGLDisplay dpy,
+    EGLContext ctx
+) {
+    fake_call(FAKE_eglDestroyContext);
+    int *fake = ctx;
+    if (
+        !fake_display_valid(dpy) ||
+        fake < fake_contexts ||
+        fake >= fake_contexts + countof(fake_contexts)
+    ) {
+        fake_error = EGL_BAD_CONTEXT;
+        return EGL_FALSE;
+    }
+    fake_contexts_used[fake - fake_contexts] = false;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglDestroySurface(
+    EGLDisplay dpy,
+    EGLSurface surface
+) {
+    fake_call(FAKE_eglDestroySurface);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    fake->used = false;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetConfigAttrib(
+    EGLDisplay dpy,
+    EGLConfig config,
+    EGLint attribute,
+    EGLint *value
+) {
+    fake_call(FAKE_eglGetConfigAttrib);
+    const FakeConfig *fake = fake_config(config);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    *value = fake_config_attrib(fake, attribute);
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetConfigs(
+    EGLDisplay dpy,
+    EGLConfig *configs,
+    EGLint config_size,
+    EGLint *num_config
+) {
+    fake_call(FAKE_eglGetConfigs);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    EGLint n = (EGLint)countof(fake_configs);
+    if (configs != NULL) {
+        n = n < config_size ? n : config_size;
+        for (EGLint i = 0; i < n; i += 1) {
+            configs[i] = (EGLConfig)&fake_configs[i];
+        }
+    }
+    *num_config = n;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLDisplay EGLAPIENTRY eglGetCurrentDisplay(void) {
+    fake_call(FAKE_eglGetCurrentDisplay);
+    if (fake_current_context == EGL_NO_CONTEXT) {
+        return EGL_NO_DISPLAY;
+    }
+    return (EGLDisplay)&fake_display;
+}
+
+EGLAPI EGLSurface EGLAPIENTRY eglGetCurrentSurface(EGLint readdraw) {
+    fake_call(FAKE_eglGetCurrentSurface);
+    return fake_current_surface;
+}
+
+EGLAPI EGLDisplay EGLAPIENTRY eglGetDisplay(EGLNativeDisplayType display_id) {
+    fake_call(FAKE_eglGetDisplay);
+    return (EGLDisplay)&fake_display;
+}
+
+EGLAPI EGLint EGLAPIENTRY eglGetError(void) {
+    fake_call(FAKE_eglGetError);
+    EGLint error = fake_error;
+    fake_error = EGL_SUCCESS;
+    return error;
+}
+
+typedef struct {
+    const char *name;
+    SProc proc;
+} FakeProc;
+
+static const FakeProc fake_procs[] = {
+#define X(type, name, required) { "egl" #name, (SProc)egl##name },
+    SEGL_EGL_PROCS(X)
+#undef X
+#define X(type, prefix, name, ext_id) { #prefix #name, (SProc)prefix##name },
+    SEGL_EXT_PROCS(X)
+#undef X
+#define XR(type, ret, name, params, args) { "gl" #name, (SProc)gl##name },
+#define XV(type, name, params, args) { "gl" #name, (SProc)gl##name },
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+};
+
+EGLAPI __eglMustCastToProperFunctionPointerType EGLAPIENTRY eglGetProcAddress(
+    const char *procname
+) {
+    fake_call(FAKE_eglGetProcAddress);
+    for (size_t i = 0; i < countof(fake_procs); i += 1) {
+        if (strcmp(fake_procs[i].name, procname) == 0) {
+            return (__eglMustCastToProperFunctionPointerType)fake_procs[i].proc;
+        }
+    }
+    return NULL;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglInitialize(
+    EGLDisplay dpy,
+    EGLint *major,
+    EGLint *minor
+) {
+    fake_call(FAKE_eglInitialize);
+    if (dpy != (EGLDisplay)&fake_display) {
+        fake_error = EGL_BAD_DISPLAY;
+        return EGL_FALSE;
+    }
+    fake_initialized = true;
+    if (major != NULL) {
+        *major = 1;
+    }
+    if (minor != NULL) {
+        *minor = 4;
+    }
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglMakeCurrent(
+    EGLDisplay dpy,
+    EGLSurface draw,
+    EGLSurface read,
+    EGLContext ctx
+) {
+    fake_call(FAKE_eglMakeCurrent);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    if (draw != EGL_NO_SURFACE && fake_surface(draw) == NULL) {
+        return EGL_FALSE;
+    }
+    if (fake_context_lost(ctx)) {
+        fake_error = EGL_CONTEXT_LOST;
+        return EGL_FALSE;
+    }
+    fake_current_surface = draw;
+    fake_current_context = ctx;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglQueryContext(
+    EGLDisplay dpy,
+    EGLContext ctx,
+    EGLint attribute,
+    EGLint *value
+) {
+    fake_call(FAKE_eglQueryContext);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    switch (attribute) {
+        case EGL_CONTEXT_CLIENT_VERSION:
+            *value = 2;
+            return EGL_TRUE;
+        case EGL_RENDER_BUFFER:
+            *value = EGL_BACK_BUFFER;
+            return EGL_TRUE;
+        default:
+            fake_error = EGL_BAD_ATTRIBUTE;
+            return EGL_FALSE;
+    }
+}
+
+EGLAPI const char *EGLAPIENTRY eglQueryString(EGLDisplay dpy, EGLint name) {
+    fake_call(FAKE_eglQueryString);
+    if (!fake_display_valid(dpy)) {
+        return NULL;
+    }
+    switch (name) {
+        case EGL_VENDOR:
+            return "segl";
+        case EGL_VERSION:
+            return "1.4 segl-fake";
+        case EGL_CLIENT_APIS:
+            return "OpenGL_ES";
+        case EGL_EXTENSIONS: {
+            const char *exts = getenv("FAKE_EGL_EXTENSIONS");
+            if (exts != NULL) {
+                return exts;
+            }
+            return "EGL_KHR_fence_sync EGL_KHR_partial_update "
+                "EGL_ANDROID_presentation_time EGL_EXT_buffer_age "
+                "EGL_KHR_swap_buffers_with_damage "
+                "EGL_ANDROID_get_frame_timestamps "
+                "EGL_KHR_surfaceless_context";
+        }
+        default:
+            fake_error = EGL_BAD_PARAMETER;
+            return NULL;
+    }
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglQuerySurface(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLint attribute,
+    EGLint *value
+) {
+    fake_call(FAKE_eglQuerySurface);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    switch (attribute) {
+        case EGL_WIDTH:
+            *value = fake->width;
+            return EGL_TRUE;
+        case EGL_HEIGHT:
+            *value = fake->height;
+            return EGL_TRUE;
+        case EGL_BUFFER_AGE_EXT:
+            *value = fake->swaps < FAKE_BUFFER_COUNT ? 0 : FAKE_BUFFER_COUNT;
+            return EGL_TRUE;
+        case EGL_RENDER_BUFFER:
+            *value = EGL_BACK_BUFFER;
+            return EGL_TRUE;
+        default:
+            fake_error = EGL_BAD_ATTRIBUTE;
+            return EGL_FALSE;
+    }
+}
+
+static int64_t fake_now_ns(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+static int64_t fake_refresh_ns(void) {
+    const char *hz = getenv("FAKE_EGL_REFRESH_HZ");
+    if (hz == NULL || atoi(hz) <= 0) {
+        return 0;
+    }
+    return 1000000000L / atoi(hz);
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSurfaceAttrib(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLint attribute,
+    EGLint value
+) {
+    fake_call(FAKE_eglSurfaceAttrib);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    switch (attribute) {
+        case EGL_TIMESTAMPS_ANDROID:
+            fake->timestamps = value != EGL_FALSE;
+            return EGL_TRUE;
+        case EGL_SWAP_BEHAVIOR:
+            return value == EGL_BUFFER_DESTROYED;
+        default:
+            fake_error = EGL_BAD_ATTRIBUTE;
+            return EGL_FALSE;
+    }
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSwapBuffers(
+    EGLDisplay dpy,
+    EGLSurface surface
+) {
+    fake_call(FAKE_eglSwapBuffers);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    if (fake_context_lost(fake_current_context)) {
+        fake_error = EGL_CONTEXT_LOST;
+        return EGL_FALSE;
+    }
+    fake->swaps += 1;
+    fake->swap_ns[fake->swaps % FAKE_TIMESTAMP_LEN] = fake_now_ns();
+    fake->requested_ns[fake->swaps % FAKE_TIMESTAMP_LEN] = (
+        fake->next_requested_ns
+    );
+    fake->next_requested_ns = EGL_TIMESTAMP_INVALID_ANDROID;
+
+    int64_t period_ns = fake_refresh_ns();
+    if (period_ns > 0 && fake->swap_interval > 0) {
+        int64_t now_ns = fake_now_ns();
+
+        // NOTE: a late frame waits for the next vsync after it was queued
+        int64_t vsync_ns = (
+            fake->last_vsync_ns + period_ns * fake->swap_interval
+        );
+        if (vsync_ns < now_ns) {
+            vsync_ns = (now_ns / period_ns + 1) * period_ns;
+        }
+        const struct timespec vsync = {
+            .tv_sec = vsync_ns / 1000000000L,
+            .tv_nsec = vsync_ns % 1000000000L,
+        };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &vsync, NULL);
+        fake->last_vsync_ns = vsync_ns;
+    }
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSwapInterval(
+    EGLDisplay dpy,
+    EGLint interval
+) {
+    fake_call(FAKE_eglSwapInterval);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    FakeSurface *fake = fake_surface(fake_current_surface);
+    if (fake == NULL) {
+        return EGL_FALSE;
+    }
+    fake->swap_interval = interval < 0 ? 0 : interval > 4 ? 4 : interval;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglTerminate(EGLDisplay dpy) {
+    fake_call(FAKE_eglTerminate);
+    if (dpy != (EGLDisplay)&fake_display) {
+        fake_error = EGL_BAD_DISPLAY;
+        return EGL_FALSE;
+    }
+    fake_initialized = false;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglWaitGL(void) {
+    fake_call(FAKE_eglWaitGL);
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglWaitNative(EGLint engine) {
+    fake_call(FAKE_eglWaitNative);
+    return EGL_TRUE;
+}
+
+EGLAPI EGLSyncKHR EGLAPIENTRY eglCreateSyncKHR(
+    EGLDisplay dpy,
+    EGLenum type,
+    const EGLint *attrib_list
+) {
+    fake_call(FAKE_eglCreateSyncKHR);
+    if (!fake_display_valid(dpy)) {
+        return EGL_NO_SYNC_KHR;
+    }
+    return &fake_syncs[0];
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglDestroySyncKHR(
+    EGLDisplay dpy,
+    EGLSyncKHR sync
+) {
+    fake_call(FAKE_eglDestroySyncKHR);
+    return fake_display_valid(dpy);
+}
+
+EGLAPI EGLint EGLAPIENTRY eglClientWaitSyncKHR(
+    EGLDisplay dpy,
+    EGLSyncKHR sync,
+    EGLint flags,
+    EGLTimeKHR timeout
+) {
+    fake_call(FAKE_eglClientWaitSyncKHR);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    return EGL_CONDITION_SATISFIED_KHR;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetSyncAttribKHR(
+    EGLDisplay dpy,
+    EGLSyncKHR sync,
+    EGLint attribute,
+    EGLint *value
+) {
+    fake_call(FAKE_eglGetSyncAttribKHR);
+    if (!fake_display_valid(dpy)) {
+        return EGL_FALSE;
+    }
+    switch (attribute) {
+        case EGL_SYNC_TYPE_KHR:
+            *value = EGL_SYNC_FENCE_KHR;
+            return EGL_TRUE;
+        case EGL_SYNC_STATUS_KHR:
+            *value = EGL_SIGNALED_KHR;
+            return EGL_TRUE;
+        case EGL_SYNC_CONDITION_KHR:
+            *value = EGL_SYNC_PRIOR_COMMANDS_COMPLETE_KHR;
+            return EGL_TRUE;
+        default:
+            fake_error = EGL_BAD_ATTRIBUTE;
+            return EGL_FALSE;
+    }
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSetDamageRegionKHR(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLint *rects,
+    EGLint n_rects
+) {
+    fake_call(FAKE_eglSetDamageRegionKHR);
+    return fake_display_valid(dpy) && fake_surface(surface) != NULL;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageKHR(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    const EGLint *rects,
+    EGLint n_rects
+) {
+    fake_call(FAKE_eglSwapBuffersWithDamageKHR);
+    if (n_rects < 0 || (n_rects > 0 && rects == NULL)) {
+        fake_error = EGL_BAD_PARAMETER;
+        return EGL_FALSE;
+    }
+    return eglSwapBuffers(dpy, surface);
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglPresentationTimeANDROID(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLnsecsANDROID time
+) {
+    fake_call(FAKE_eglPresentationTimeANDROID);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    fake->next_requested_ns = time;
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetNextFrameIdANDROID(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLuint64KHR *frameId
+) {
+    fake_call(FAKE_eglGetNextFrameIdANDROID);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    if (!fake->timestamps) {
+        fake_error = EGL_BAD_SURFACE;
+        return EGL_FALSE;
+    }
+    *frameId = fake->swaps + 1;
+    return EGL_TRUE;
+}
+
+static bool fake_timestamp_supported(EGLint timestamp) {
+    return (
+        timestamp >= EGL_REQUESTED_PRESENT_TIME_ANDROID &&
+        timestamp <= EGL_READS_DONE_TIME_ANDROID
+    );
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetFrameTimestampSupportedANDROID(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLint timestamp
+) {
+    fake_call(FAKE_eglGetFrameTimestampSupportedANDROID);
+    return (
+        fake_display_valid(dpy) &&
+        fake_surface(surface) != NULL &&
+        fake_timestamp_supported(timestamp)
+    );
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglGetFrameTimestampsANDROID(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLuint64KHR frameId,
+    EGLint numTimestamps,
+    const EGLint *timestamps,
+    EGLnsecsANDROID *values
+) {
+    fake_call(FAKE_eglGetFrameTimestampsANDROID);
+    FakeSurface *fake = fake_surface(surface);
+    if (!fake_display_valid(dpy) || fake == NULL) {
+        return EGL_FALSE;
+    }
+    if (!fake->timestamps) {
+        fake_error = EGL_BAD_SURFACE;
+        return EGL_FALSE;
+    }
+    if (
+        frameId == 0 ||
+        frameId > fake->swaps ||
+        fake->swaps - frameId >= FAKE_TIMESTAMP_LEN
+    ) {
+        fake_error = EGL_BAD_ACCESS;
+        return EGL_FALSE;
+    }
+
+    int64_t period_ns = fake_refresh_ns();
+    if (period_ns <= 0) {
+        period_ns = 1000000000L / 60;
+    }
+    int64_t swap_ns = fake->swap_ns[frameId % FAKE_TIMESTAMP_LEN];
+    EGLnsecsANDROID requested_ns = fake->requested_ns[
+        frameId % FAKE_TIMESTAMP_LEN
+    ];
+    int64_t gpu_ns = swap_ns + period_ns / 4;
+    int64_t latch_ns = (gpu_ns / period_ns + 1) * period_ns;
+    if (requested_ns > latch_ns + period_ns) {
+        // the first vsync at or after the requested time presents it
+        int64_t vsyncs = (requested_ns + period_ns - 1) / period_ns;
+        latch_ns = (vsyncs - 1) * period_ns;
+    }
+    int64_t present_ns = latch_ns + period_ns;
+
+    int64_t now_ns = fake_now_ns();
+    for (EGLint i = 0; i < numTimestamps; i += 1) {
+        int64_t value;
+        switch (timestamps[i]) {
+            case EGL_REQUESTED_PRESENT_TIME_ANDROID:
+                values[i] = requested_ns;
+                continue;
+            case EGL_RENDERING_COMPLETE_TIME_ANDROID:
+                value = gpu_ns;
+                break;
+            case EGL_COMPOSITION_LATCH_TIME_ANDROID:
+                value = latch_ns;
+                break;
+            case EGL_DISPLAY_PRESENT_TIME_ANDROID:
+                value = present_ns;
+                break;
+            default:
+                if (!fake_timestamp_supported(timestamps[i])) {
+                    fake_error = EGL_BAD_PARAMETER;
+                    return EGL_FALSE;
+                }
+                values[i] = EGL_TIMESTAMP_INVALID_ANDROID;
+                continue;
+        }
+        values[i] = value <= now_ns ? value : EGL_TIMESTAMP_PENDING_ANDROID;
+    }
+    return EGL_TRUE;
+}
@@ -0,0 +1,332 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#define GL_GLEXT_PROTOTYPES 1
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fake.h"
+
+const char *const fake_proc_names[FAKE_PROC_COUNT] = {
+#define X(type, name, required) "egl" #name,
+    SEGL_EGL_PROCS(X)
+#undef X
+#define X(type, prefix, name, ext_id) #prefix #name,
+    SEGL_EXT_PROCS(X)
+#undef X
+#define XR(type, ret, name, params, args) "gl" #name,
+#define XV(type, name, params, args) "gl" #name,
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+};
+
+static atomic_uint_least64_t fake_counts[FAKE_PROC_COUNT];
+static int64_t fake_latency_ns[FAKE_PROC_COUNT];
+
+static int fake_proc_find(const char *name, size_t len) {
+    for (int i = 0; i < FAKE_PROC_COUNT; i += 1) {
+        if (
+            strncmp(fake_proc_names[i], name, len) == 0 &&
+            fake_proc_names[i][len] == '\0'
+        ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void fake_call(int id) {
+    atomic_fetch_add_explicit(&fake_counts[id], 1, memory_order_relaxed);
+    if (fake_latency_ns[id] > 0) {
+        const TimeSpec duration = {
+            .tv_sec = fake_latency_ns[id] / (1000L * 1000L * 1000L),
+            .tv_nsec = fake_latency_ns[id] % (1000L * 1000L * 1000L),
+        };
+        nanosleep(&duration, NULL);
+    }
+}
+
+uint64_t fake_call_count(const char *name) {
+    int id = fake_proc_find(name, strlen(name));
+    if (id < 0) {
+        return 0;
+    }
+    return atomic_load_explicit(&fake_counts[id], memory_order_relaxed);
+}
+
+void fake_set_latency(const char *name, int64_t latency_ns) {
+    int id = fake_proc_find(name, strlen(name));
+    if (id < 0) {
+        fprintf(stderr, "fake: unknown function %s\n", name);
+        return;
+    }
+    fake_latency_ns[id] = latency_ns;
+}
+
+void fake_reset(void) {
+    for (int i = 0; i < FAKE_PROC_COUNT; i += 1) {
+        atomic_store_explicit(&fake_counts[i], 0, memory_order_relaxed);
+    }
+}
+
+static void fake_report(void) {
+    for (int i = 0; i < FAKE_PROC_COUNT; i += 1) {
+        uint64_t count = atomic_load_explicit(
+            &fake_counts[i],
+            memory_order_relaxed
+        );
+        if (count > 0) {
+            fprintf(
+                stderr,
+                "fake: %s called %llu times\n",
+                fake_proc_names[i],
+                (unsigned long long)count
+            );
+        }
+    }
+}
+
+// Parses FAKE_EGL_LATENCY_US, a comma separated list of name=microseconds.
+__attribute__((constructor))
+static void fake_init(void) {
+    const char *latency = getenv("FAKE_EGL_LATENCY_US");
+    while (latency != NULL && *latency != '\0') {
+        size_t len = strcspn(latency, ",");
+        size_t name_len = strcspn(latency, "=,");
+        int id = fake_proc_find(latency, name_len);
+        if (id >= 0 && name_len < len) {
+            fake_latency_ns[id] = strtoll(latency + name_len + 1, NULL, 10) *
+                1000L;
+        } else {
+            fprintf(
+                stderr,
+                "fake: ignoring latency entry %.*s\n",
+                (int)len,
+                latency
+            );
+        }
+        latency += len;
+        if (*latency == ',') {
+            latency += 1;
+        }
+    }
+
+    if (getenv("FAKE_EGL_REPORT") != NULL) {
+        atexit(fake_report);
+    }
+}
+
+static GLuint fake_next_name = 1;
+
+static void fake_gen_names(GLsizei n, GLuint *names) {
+    for (GLsizei i = 0; i < n; i += 1) {
+        names[i] = fake_next_name;
+        fake_next_name += 1;
+    }
+}
+
+GL_APICALL GLenum GL_APIENTRY glCheckFramebufferStatus(GLenum target) {
+    fake_call(FAKE_glCheckFramebufferStatus);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+// NOTE: the framebuffer is a single color, enough for readback checks
+static _Thread_local GLfloat fake_clear_color[4];
+static _Thread_local GLfloat fake_framebuffer_color[4];
+
+GL_APICALL void GL_APIENTRY glClear(GLbitfield mask) {
+    fake_call(FAKE_glClear);
+    if ((mask & GL_COLOR_BUFFER_BIT) != 0) {
+        memcpy(
+            fake_framebuffer_color,
+            fake_clear_color,
+            sizeof(fake_framebuffer_color)
+        );
+    }
+}
+
+GL_APICALL void GL_APIENTRY glClearColor(
+    GLfloat red,
+    GLfloat green,
+    GLfloat blue,
+    GLfloat alpha
+) {
+    fake_call(FAKE_glClearColor);
+    fake_clear_color[0] = red;
+    fake_clear_color[1] = green;
+    fake_clear_color[2] = blue;
+    fake_clear_color[3] = alpha;
+}
+
+GL_APICALL GLuint GL_APIENTRY glCreateProgram(void) {
+    fake_call(FAKE_glCreateProgram);
+    GLuint program;
+    fake_gen_names(1, &program);
+    return program;
+}
+
+GL_APICALL GLuint GL_APIENTRY glCreateShader(GLenum type) {
+    fake_call(FAKE_glCreateShader);
+    GLuint shader;
+    fake_gen_names(1, &shader);
+    return shader;
+}
+
+GL_APICALL void GL_APIENTRY glGenBuffers(GLsizei n, GLuint *buffers) {
+    fake_call(FAKE_glGenBuffers);
+    fake_gen_names(n, buffers);
+}
+
+GL_APICALL void GL_APIENTRY glGenFramebuffers(GLsizei n, GLuint *framebuffers) {
+    fake_call(FAKE_glGenFramebuffers);
+    fake_gen_names(n, framebuffers);
+}
+
+GL_APICALL void GL_APIENTRY glGenRenderbuffers(
+    GLsizei n,
+    GLuint *renderbuffers
+) {
+    fake_call(FAKE_glGenRenderbuffers);
+    fake_gen_names(n, renderbuffers);
+}
+
+GL_APICALL void GL_APIENTRY glGenTextures(GLsizei n, GLuint *textures) {
+    fake_call(FAKE_glGenTextures);
+    fake_gen_names(n, textures);
+}
+
+GL_APICALL GLenum GL_APIENTRY glGetError(void) {
+    fake_call(FAKE_glGetError);
+    return GL_NO_ERROR;
+}
+
+GL_APICALL void GL_APIENTRY glGetIntegerv(GLenum pname, GLint *data) {
+    fake_call(FAKE_glGetIntegerv);
+    switch (pname) {
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_RENDERBUFFER_SIZE:
+            *data = 4096;
+            break;
+        case GL_MAX_VERTEX_ATTRIBS:
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+            *data = 16;
+            break;
+        default:
+            *data = 0;
+            break;
+    }
+}
+
+GL_APICALL void GL_APIENTRY glGetProgramiv(
+    GLuint program,
+    GLenum pname,
+    GLint *params
+) {
+    fake_call(FAKE_glGetProgramiv);
+    *params = pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS;
+}
+
+GL_APICALL void GL_APIENTRY glGetShaderiv(
+    GLuint shader,
+    GLenum pname,
+    GLint *params
+) {
+    fake_call(FAKE_glGetShaderiv);
+    *params = pname == GL_COMPILE_STATUS;
+}
+
+GL_APICALL const GLubyte *GL_APIENTRY glGetString(GLenum name) {
+    fake_call(FAKE_glGetString);
+    const char *str = NULL;
+    switch (name) {
+        case GL_VENDOR:
+            str = "segl";
+            break;
+        case GL_RENDERER:
+            str = "segl fake renderer";
+            break;
+        case GL_VERSION:
+            str = "OpenGL ES 2.0 segl-fake";
+            break;
+        case GL_SHADING_LANGUAGE_VERSION:
+            str = "OpenGL ES GLSL ES 1.00";
+            break;
+        case GL_EXTENSIONS:
+            str = getenv("FAKE_GL_EXTENSIONS");
+            if (str == NULL) {
+                str = "GL_EXT_discard_framebuffer GL_OES_vertex_array_object";
+            }
+            break;
+        default:
+            break;
+    }
+    return (const GLubyte *)str;
+}
+
+GL_APICALL void GL_APIENTRY glReadPixels(
+    GLint x,
+    GLint y,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    void *pixels
+) {
+    fake_call(FAKE_glReadPixels);
+    if (format != GL_RGBA || type != GL_UNSIGNED_BYTE) {
+        return;
+    }
+    GLubyte rgba[4];
+    for (int c = 0; c < 4; c += 1) {
+        rgba[c] = (GLubyte)(fake_framebuffer_color[c] * 255.0f + 0.5f);
+    }
+    GLubyte *out = pixels;
+    for (GLsizei i = 0; i < width * height; i += 1) {
+        memcpy(out + i * 4, rgba, sizeof(rgba));
+    }
+}
+
+GL_APICALL void GL_APIENTRY glDiscardFramebufferEXT(
+    GLenum target,
+    GLsizei numAttachments,
+    const GLenum *attachments
+) {
+    fake_call(FAKE_glDiscardFramebufferEXT);
+}
+
+GL_APICALL void GL_APIENTRY glBindVertexArrayOES(GLuint array) {
+    fake_call(FAKE_glBindVertexArrayOES);
+}
+
+GL_APICALL void GL_APIENTRY glDeleteVertexArraysOES(
+    GLsizei n,
+    const GLuint *arrays
+) {
+    fake_call(FAKE_glDeleteVertexArraysOES);
+}
+
+GL_APICALL void GL_APIENTRY glGenVertexArraysOES(GLsizei n, GLuint *arrays) {
+    fake_call(FAKE_glGenVertexArraysOES);
+    fake_gen_names(n, arrays);
+}
+
+GL_APICALL GLboolean GL_APIENTRY glIsVertexArrayOES(GLuint array) {
+    fake_call(FAKE_glIsVertexArrayOES);
+    return GL_TRUE;
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Weak default implementations of every core GLES2 function for the fake
+// libGLESv2.so. They only count the call; fake_gles2.c overrides the ones
+// that have to return or write something meaningful.
+
+#include "fake.h"
+
+#define XR(type, ret, name, params, args) \
+    __attribute__((weak)) GL_APICALL ret GL_APIENTRY gl##name params { \
+        fake_call(FAKE_gl##name); \
+        return (ret)0; \
+    }
+#define XV(type, name, params, args) \
+    __attribute__((weak)) GL_APICALL void GL_APIENTRY gl##name params { \
+        fake_call(FAKE_gl##name); \
+    }
+SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Headless run of the app's render path without any native window, e.g.
+// against Mesa's llvmpipe in CI:
+//     EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./build_host/headless
+// taking optional [frames] [WxH] arguments.
+// SEGL_LIBEGL_PATH selects libEGL (default libEGL.so.1) and SEGL_HEADLESS
+// selects pbuffer (default) or surfaceless. Prints the time per frame and
+// exits non-zero when the rendered color does not match the scene.
+// headless_atrace is the same built with -DSEGL_ATRACE, and prints the
+// ATrace sections of loading and of each frame as trace_marker lines.
+// SEGL_HUD=1 draws the performance HUD over every frame, so comparing the
+// time per frame with and without it gives its cost.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hud.h"
+#include "scene.h"
+#include "segl.h"
+#include "segl_log.h"
+#include "segl_trace.h"
+
+static SEglVtable egl;
+static SGlVtable gl;
+static SEglExt ext;
+static Hud hud;
+
+static int64_t headless_now(clockid_t clock) {
+    TimeSpec now;
+    clock_gettime(clock, &now);
+    return (int64_t)now.tv_sec * 1000L * 1000L * 1000L + now.tv_nsec;
+}
+
+static int headless_channel_error(float expected, GLubyte actual) {
+    int error = (int)(expected * 255.0f + 0.5f) - (int)actual;
+    return error < 0 ? -error : error;
+}
+
+int main(int argc, char **argv) {
+    long frames = argc > 1 ? atol(argv[1]) : 1000;
+    int width = 1280;
+    int height = 720;
+    if (argc > 2 && sscanf(argv[2], "%dx%d", &width, &height) != 2) {
+        fprintf(stderr, "usage: %s [frames] [WxH]\n", argv[0]);
+        return 2;
+    }
+
+    const char *egl_path = getenv("SEGL_LIBEGL_PATH");
+    if (egl_path == NULL) {
+        egl_path = "libEGL.so.1";
+    }
+    SEglHeadlessMode mode = SEGL_HEADLESS_PBUFFER;
+    const char *mode_name = getenv("SEGL_HEADLESS");
+    if (mode_name != NULL && strcmp(mode_name, "surfaceless") == 0) {
+        mode = SEGL_HEADLESS_SURFACELESS;
+    }
+
+    segl_log_start();
+    SEGL_ATRACE_LOAD();
+    egl = segl_vtable_load(egl_path, NULL);
+    sgl_vtable_load(&gl, &egl, NULL);
+
+    const SEglConfigSpec config_spec = {
+        .policy = SEGL_CONFIG_PERFORMANCE,
+    };
+    SEglCtx egl_ctx = segl_ctx_headless_load(
+        mode,
+        width,
+        height,
+        &egl,
+        &config_spec,
+        &mode
+    );
+    segl_ext_load(&ext, &egl, &gl, egl_ctx.display, NULL);
+    printf(
+        "renderer: %s (%s, %dx%d)\n",
+        (const char *)gl.GetString(GL_RENDERER),
+        mode == SEGL_HEADLESS_PBUFFER ? "pbuffer" : "surfaceless",
+        width,
+        height
+    );
+
+    // NOTE: RGB565 renderbuffers are core in ES 2.0, unlike RGBA8
+    GLuint framebuffer = 0;
+    GLuint renderbuffer = 0;
+    int color_bits = egl_ctx.attribs.red;
+    if (egl_ctx.attribs.green < color_bits) {
+        color_bits = egl_ctx.attribs.green;
+    }
+    if (egl_ctx.attribs.blue < color_bits) {
+        color_bits = egl_ctx.attribs.blue;
+    }
+    if (mode == SEGL_HEADLESS_SURFACELESS) {
+        gl.GenFramebuffers(1, &framebuffer);
+        gl.GenRenderbuffers(1, &renderbuffer);
+        gl.BindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGB565, width, height);
+        gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        gl.FramebufferRenderbuffer(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_RENDERBUFFER,
+            renderbuffer
+        );
+        if (
+            gl.CheckFramebufferStatus(GL_FRAMEBUFFER) !=
+            GL_FRAMEBUFFER_COMPLETE
+        ) {
+            fprintf(stderr, "incomplete headless framebuffer\n");
+            segl_log_flush();
+            return 1;
+        }
+        color_bits = 5;
+    }
+
+    // NOTE: finishing every frame makes the time cover the rendering
+    // itself and not just command submission
+    Scene scene;
+    scene_init(&scene);
+    gl.Viewport(0, 0, width, height);
+    hud_init(&hud, 16666667L);
+    const char *hud_name = getenv("SEGL_HUD");
+    if (hud_name != NULL && strcmp(hud_name, "1") == 0) {
+        hud_toggle(&hud);
+    }
+    const SEglRect hud_area = { 0, 0, width, height };
+    int64_t start = headless_now(CLOCK_MONOTONIC);
+    int64_t last_ns = start;
+    int64_t cpu_start = headless_now(CLOCK_PROCESS_CPUTIME_ID);
+    for (long i = 0; i < frames; i += 1) {
+        SEGL_TRACE_BEGIN("frame");
+        scene_step(&scene);
+        scene_draw(&scene, &scene, 1.0f, &gl);
+        hud_draw(&hud, &hud_area, width, height, &gl);
+        if (egl_ctx.surface != EGL_NO_SURFACE) {
+            egl.SwapBuffers(egl_ctx.display, egl_ctx.surface);
+        }
+        gl.Finish();
+        SEGL_TRACE_END("frame");
+        int64_t now_ns = headless_now(CLOCK_MONOTONIC);
+        hud_frame(
+            &hud,
+            &(HudFrame){
+                .frame_ns = now_ns - last_ns,
+                .phase_ns = { [FRAME_PHASE_ISSUE] = now_ns - last_ns },
+            },
+            now_ns
+        );
+        last_ns = now_ns;
+    }
+    int64_t frame_ns = headless_now(CLOCK_MONOTONIC) - start;
+    int64_t cpu_ns = headless_now(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    printf(
+        "frames: %ld in %lld ns (%lld ns/frame, %lld ns CPU/frame)\n",
+        frames,
+        (long long)frame_ns,
+        (long long)(frames > 0 ? frame_ns / frames : 0),
+        (long long)(frames > 0 ? cpu_ns / frames : 0)
+    );
+
+    float rgb[3];
+    scene_color(&scene, rgb);
+    GLubyte pixel[4] = { 0 };
+    gl.ReadPixels(
+        width / 2,
+        height / 2,
+        1,
+        1,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        pixel
+    );
+    int tolerance = color_bits > 0 && color_bits < 8 ? 256 >> color_bits : 1;
+    int status = 0;
+    for (int c = 0; c < 3; c += 1) {
+        if (headless_channel_error(rgb[c], pixel[c]) > tolerance) {
+            status = 1;
+        }
+    }
+    printf(
+        "readback: %u %u %u, expected %d %d %d: %s\n",
+        pixel[0],
+        pixel[1],
+        pixel[2],
+        (int)(rgb[0] * 255.0f + 0.5f),
+        (int)(rgb[1] * 255.0f + 0.5f),
+        (int)(rgb[2] * 255.0f + 0.5f),
+        status == 0 ? "ok" : "MISMATCH"
+    );
+
+    if (framebuffer != 0) {
+        gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+        gl.DeleteFramebuffers(1, &framebuffer);
+        gl.DeleteRenderbuffers(1, &renderbuffer);
+    }
+    segl_ctx_unload(&egl_ctx, &egl);
+    segl_log_flush();
+    return status;
+}
@@ -0,0 +1,574 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Host checks of the app's pure logic, without EGL or a GPU. Prints one
+// line per check and exits non-zero if any fails:
+//     ./build_host/test
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fixed_step.h"
+#include "frame_pacer.h"
+#include "histogram.h"
+#include "scene.h"
+#include "segl.h"
+#include "segl_damage.h"
+#include "segl_scale.h"
+#include "segl_surface.h"
+
+static int test_failures;
+
+static void test_check(bool ok, const char *what) {
+    printf("%s: %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) {
+        test_failures += 1;
+    }
+}
+
+// A driver's config list, in the order eglChooseConfig would return it.
+static const SEglConfigAttribs test_configs[] = {
+    // RGB565, no depth/stencil, no MSAA
+    {
+        .config_id = 1,
+        .red = 5, .green = 6, .blue = 5, .alpha = 0,
+        .depth = 0, .stencil = 0, .samples = 0,
+        .surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_NONE,
+    },
+    // RGBA8888, depth 24, stencil 8
+    {
+        .config_id = 2,
+        .red = 8, .green = 8, .blue = 8, .alpha = 8,
+        .depth = 24, .stencil = 8, .samples = 0,
+        .surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_NONE,
+    },
+    // RGBA8888, depth 24, stencil 8, 4x MSAA
+    {
+        .config_id = 3,
+        .red = 8, .green = 8, .blue = 8, .alpha = 8,
+        .depth = 24, .stencil = 8, .samples = 4,
+        .surface_type = EGL_WINDOW_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_NONE,
+    },
+    // 8x MSAA, but slow
+    {
+        .config_id = 4,
+        .red = 8, .green = 8, .blue = 8, .alpha = 8,
+        .depth = 24, .stencil = 8, .samples = 8,
+        .surface_type = EGL_WINDOW_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_SLOW_CONFIG,
+    },
+    // 16x MSAA, but non-conformant
+    {
+        .config_id = 5,
+        .red = 8, .green = 8, .blue = 8, .alpha = 8,
+        .depth = 24, .stencil = 8, .samples = 16,
+        .surface_type = EGL_WINDOW_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_NON_CONFORMANT_CONFIG,
+    },
+    // the fewest bits of all, but no window surfaces
+    {
+        .config_id = 6,
+        .red = 4, .green = 4, .blue = 4, .alpha = 0,
+        .depth = 0, .stencil = 0, .samples = 0,
+        .surface_type = EGL_PBUFFER_BIT,
+        .renderable_type = EGL_OPENGL_ES2_BIT,
+        .color_buffer_type = EGL_RGB_BUFFER,
+        .caveat = EGL_NONE,
+    },
+};
+
+static int test_config_id(const SEglConfigSpec *spec) {
+    int i = segl_config_select(
+        test_configs,
+        (int)countof(test_configs),
+        spec
+    );
+    return i < 0 ? -1 : test_configs[i].config_id;
+}
+
+static SEglConfigSpec test_config_spec(SEglConfigPolicy policy) {
+    return (SEglConfigSpec){
+        .policy = policy,
+        .surface_type = EGL_WINDOW_BIT,
+        .exact = {
+            .red = 8,
+            .green = 8,
+            .blue = 8,
+            .alpha = 8,
+            .depth = 24,
+            .stencil = 8,
+            .samples = 0,
+        },
+    };
+}
+
+static void test_config_select(void) {
+    SEglConfigSpec spec = test_config_spec(SEGL_CONFIG_PERFORMANCE);
+    test_check(test_config_id(&spec) == 1, "config performance: RGB565");
+
+    spec = test_config_spec(SEGL_CONFIG_QUALITY);
+    test_check(test_config_id(&spec) == 3, "config quality: 4x MSAA");
+
+    spec = test_config_spec(SEGL_CONFIG_EXACT);
+    test_check(test_config_id(&spec) == 2, "config exact: RGBA8888 24/8");
+
+    spec.exact.samples = 4;
+    test_check(test_config_id(&spec) == 3, "config exact: 4x MSAA");
+
+    spec.exact = (SEglConfigAttribs){
+        .red = 5,
+        .green = 6,
+        .blue = 5,
+        .alpha = EGL_DONT_CARE,
+        .depth = EGL_DONT_CARE,
+        .stencil = EGL_DONT_CARE,
+        .samples = EGL_DONT_CARE,
+    };
+    test_check(test_config_id(&spec) == 1, "config exact: don't care");
+
+    spec = test_config_spec(SEGL_CONFIG_PERFORMANCE);
+    spec.surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT;
+    test_check(
+        segl_config_select(test_configs + 2, 4, &spec) == -1,
+        "config none usable"
+    );
+}
+
+static const char *test_egl_vendor = "fake";
+
+static const char *EGLAPIENTRY test_query_string(
+    EGLDisplay dpy,
+    EGLint name
+) {
+    return name == EGL_VENDOR ? test_egl_vendor : "1.5 fake";
+}
+
+// Finds EGL_CONFIG_ID in the list, the only attribute the cache uses.
+static EGLBoolean EGLAPIENTRY test_choose_config(
+    EGLDisplay dpy,
+    const EGLint *attrib_list,
+    EGLConfig *configs,
+    EGLint config_size,
+    EGLint *num_config
+) {
+    *num_config = 0;
+    if (attrib_list[0] != EGL_CONFIG_ID) {
+        return EGL_FALSE;
+    }
+    for (size_t i = 0; i < countof(test_configs); i += 1) {
+        if (test_configs[i].config_id == attrib_list[1]) {
+            configs[0] = (EGLConfig)(uintptr_t)(i + 1);
+            *num_config = 1;
+        }
+    }
+    return EGL_TRUE;
+}
+
+static bool test_config_cached(
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec,
+    int config_id
+) {
+    SEglConfigAttribs chosen = { 0 };
+    EGLConfig config = segl_config_from_cache(
+        segl_vtable,
+        EGL_DEFAULT_DISPLAY,
+        spec,
+        &chosen
+    );
+    if (config_id < 0) {
+        return config == NULL;
+    }
+    return config != NULL && chosen.config_id == config_id;
+}
+
+static void test_config_cache(void) {
+    const SEglVtable segl_vtable = {
+        .QueryString = test_query_string,
+        .ChooseConfig = test_choose_config,
+    };
+    static SEglCache cache;
+    SEglConfigSpec spec = test_config_spec(SEGL_CONFIG_EXACT);
+    cache = (SEglCache){
+        .policy = spec.policy,
+        .surface_type = spec.surface_type,
+        .exact = spec.exact,
+        .attribs = test_configs[1],
+    };
+    snprintf(cache.egl_vendor, sizeof(cache.egl_vendor), "fake");
+    snprintf(cache.egl_version, sizeof(cache.egl_version), "1.5 fake");
+    spec.cache = &cache;
+
+    test_check(test_config_cached(&segl_vtable, &spec, 2), "cache hit");
+
+    spec.policy = SEGL_CONFIG_QUALITY;
+    test_check(
+        test_config_cached(&segl_vtable, &spec, -1),
+        "cache miss: policy"
+    );
+    spec.policy = SEGL_CONFIG_EXACT;
+
+    spec.exact.samples = 4;
+    test_check(
+        test_config_cached(&segl_vtable, &spec, -1),
+        "cache miss: exact sizes"
+    );
+    spec.exact.samples = 0;
+
+    spec.surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT;
+    test_check(
+        test_config_cached(&segl_vtable, &spec, -1),
+        "cache miss: surface type"
+    );
+    spec.surface_type = EGL_WINDOW_BIT;
+
+    test_egl_vendor = "other";
+    test_check(
+        test_config_cached(&segl_vtable, &spec, -1),
+        "cache miss: EGL vendor"
+    );
+    test_egl_vendor = "fake";
+
+    cache.attribs.config_id = 42;
+    test_check(
+        test_config_cached(&segl_vtable, &spec, -1),
+        "cache miss: config gone"
+    );
+}
+
+static void test_damage(void) {
+    SEglDamageRegion region = { 0 };
+    segl_damage_region_add(&region, (SEglRect){ 0, 0, 100, 100 });
+    segl_damage_region_add(&region, (SEglRect){ 10, 10, 20, 20 });
+    segl_damage_region_add(&region, (SEglRect){ 50, 50, 0, 10 });
+    test_check(
+        region.nrects == 1 && segl_damage_region_area(&region, 0, 0) == 10000,
+        "damage drops contained and empty rects"
+    );
+
+    for (int i = 1; i <= SEGL_DAMAGE_MAX_RECTS; i += 1) {
+        segl_damage_region_add(&region, (SEglRect){ i * 200, 0, 10, 10 });
+    }
+    const SEglRect *bounds = &region.rects[0];
+    test_check(
+        region.nrects == 1 &&
+            bounds->x == 0 &&
+            bounds->y == 0 &&
+            bounds->width == SEGL_DAMAGE_MAX_RECTS * 200 + 10 &&
+            bounds->height == 100,
+        "damage collapses into the bounding box"
+    );
+
+    region.full = true;
+    test_check(
+        segl_damage_region_area(&region, 640, 480) == 640 * 480,
+        "damage full region covers the surface"
+    );
+}
+
+static EGLint test_surface_width;
+static EGLint test_surface_height;
+
+static EGLBoolean EGLAPIENTRY test_query_surface(
+    EGLDisplay dpy,
+    EGLSurface surface,
+    EGLint attribute,
+    EGLint *value
+) {
+    *value = attribute == EGL_WIDTH ? test_surface_width : test_surface_height;
+    return EGL_TRUE;
+}
+
+static void test_surface_resized(
+    const SEglSurfaceState *state,
+    void *userdata
+) {
+    int *calls = userdata;
+    *calls += 1;
+}
+
+static bool test_rect_eq(
+    SEglRect rect,
+    EGLint x,
+    EGLint y,
+    EGLint width,
+    EGLint height
+) {
+    return (
+        rect.x == x &&
+        rect.y == y &&
+        rect.width == width &&
+        rect.height == height
+    );
+}
+
+static void test_surface(void) {
+    const SEglVtable segl_vtable = { .QuerySurface = test_query_surface };
+    const SEglCtx segl_ctx = { .surface = (EGLSurface)1 };
+    static SEglSurfaceState state;
+    int calls = 0;
+    segl_surface_init(&state);
+    segl_surface_on_resize(&state, test_surface_resized, &calls);
+
+    test_surface_width = 1080;
+    test_surface_height = 1920;
+    bool resized = segl_surface_update(&state, &segl_ctx, &segl_vtable);
+    test_check(
+        resized &&
+            calls == 1 &&
+            test_rect_eq(state.content, 0, 0, 1080, 1920),
+        "surface size queried once invalidated"
+    );
+
+    test_surface_width = 720;
+    resized = segl_surface_update(&state, &segl_ctx, &segl_vtable);
+    test_check(
+        !resized && state.queries == 1 && calls == 1,
+        "surface size not queried again until invalidated"
+    );
+    test_surface_width = 1080;
+
+    segl_surface_content(&state, 0, 100, 1080, 1800);
+    test_check(
+        calls == 2 && test_rect_eq(state.content, 0, 120, 1080, 1700),
+        "surface content rect flipped to a bottom-left origin"
+    );
+
+    segl_surface_content(&state, 0, 100, 1080, 1800);
+    test_check(calls == 2, "surface same content rect not called back");
+
+    segl_surface_window(&state, 2160, 3840);
+    test_check(
+        calls == 3 && test_rect_eq(state.content, 0, 1020, 540, 850),
+        "surface content rect scaled to smaller buffers"
+    );
+
+    segl_surface_invalidate(&state);
+    resized = segl_surface_update(&state, &segl_ctx, &segl_vtable);
+    test_check(
+        !resized && state.queries == 2 && calls == 3,
+        "surface same size not called back"
+    );
+}
+
+// Feeds a window of frames of the same time; returns true if any of them
+// changed the scale.
+static bool test_scale_window(SEglScale *scale, int64_t frame_ns) {
+    bool changed = false;
+    for (int i = 0; i < SEGL_SCALE_WINDOW; i += 1) {
+        changed = segl_scale_frame(scale, frame_ns) || changed;
+    }
+    return changed;
+}
+
+static bool test_scale_is(const SEglScale *scale, float value) {
+    return fabsf(scale->scale - value) < 0.001f;
+}
+
+static void test_scale(void) {
+    const int64_t target_ns = 10000000;
+    SEglScale scale;
+    segl_scale_init(&scale, target_ns, 0.5f, 1.0f);
+
+    for (int i = 0; i < SEGL_SCALE_WINDOW - 1; i += 1) {
+        segl_scale_frame(&scale, 2 * target_ns);
+    }
+    test_check(test_scale_is(&scale, 1.0f), "scale waits for a full window");
+    // NOTE: twice the target at 1.0 wants sqrt(0.8 / 2), rounded down
+    segl_scale_frame(&scale, 2 * target_ns);
+    test_check(test_scale_is(&scale, 0.6f), "scale drops to the goal load");
+
+    test_check(
+        !test_scale_window(&scale, target_ns * 3 / 4) &&
+            test_scale_is(&scale, 0.6f),
+        "scale holds between the low and high loads"
+    );
+    test_check(
+        test_scale_window(&scale, target_ns / 2) &&
+            test_scale_is(&scale, 0.65f),
+        "scale grows one step under the low load"
+    );
+    test_scale_window(&scale, 10 * target_ns);
+    test_check(test_scale_is(&scale, 0.5f), "scale clamps to the minimum");
+
+    segl_scale_pin(&scale, 2.0f);
+    test_check(
+        test_scale_is(&scale, 1.0f) &&
+            !test_scale_window(&scale, 10 * target_ns) &&
+            test_scale_is(&scale, 1.0f),
+        "scale pinned, clamped and held"
+    );
+    segl_scale_unpin(&scale);
+
+    segl_scale_pin(&scale, 0.5f);
+    int32_t width;
+    int32_t height;
+    segl_scale_size(&scale, 1081, 3, &width, &height);
+    test_check(width == 540 && height == 2, "scale size even, at least 2");
+}
+
+static void test_fixed_step(void) {
+    const int64_t step_ns = 16000000;
+    FixedStep step;
+    uint64_t skipped;
+    fixed_step_init(&step, step_ns, 4, FIXED_STEP_CLAMP);
+
+    int steps = fixed_step_advance(&step, 40000000, &skipped);
+    test_check(
+        steps == 2 &&
+            skipped == 0 &&
+            fabsf(fixed_step_alpha(&step) - 0.5f) < 0.001f,
+        "fixed step runs whole steps and blends the rest"
+    );
+    steps = fixed_step_advance(&step, 1000000000, &skipped);
+    test_check(
+        steps == 4 &&
+            skipped == 0 &&
+            step.dropped_ns == 59 * step_ns &&
+            step.accumulator_ns < step_ns,
+        "fixed step clamp drops the steps past the cap"
+    );
+
+    fixed_step_init(&step, step_ns, 4, FIXED_STEP_FAST_FORWARD);
+    steps = fixed_step_advance(&step, 1000000000, &skipped);
+    test_check(
+        steps == 4 && skipped == 58 && step.accumulator_ns == 8000000,
+        "fixed step fast-forward hands out the steps past the cap"
+    );
+}
+
+static bool test_scene_advanced(uint64_t steps) {
+    Scene stepped;
+    Scene advanced;
+    scene_init(&stepped);
+    scene_init(&advanced);
+    for (uint64_t i = 0; i < steps; i += 1) {
+        scene_step(&stepped);
+    }
+    scene_advance(&advanced, steps);
+
+    float want[3];
+    float got[3];
+    scene_color(&stepped, want);
+    scene_color(&advanced, got);
+    return (
+        fabsf(want[0] - got[0]) < 0.001f &&
+        fabsf(want[1] - got[1]) < 0.001f &&
+        fabsf(want[2] - got[2]) < 0.001f
+    );
+}
+
+static void test_scene_advance(void) {
+    static const uint64_t steps[] = { 0, 1, 7, 100, 1000, 12345 };
+    bool matched = true;
+    for (size_t i = 0; i < countof(steps); i += 1) {
+        matched = test_scene_advanced(steps[i]) && matched;
+    }
+    test_check(matched, "scene advance matches repeated steps");
+}
+
+static void test_frame_pacer(void) {
+    const int64_t refresh_ns = 16666667;
+    const int64_t start_ns = 1000000000;
+    FramePacer pacer;
+    frame_pacer_init(&pacer, refresh_ns, 2);
+
+    // the frame started at vsync 2 is still in flight at vsync 4
+    uint32_t started = 0;
+    for (int k = 0; k < 8; k += 1) {
+        int64_t vsync_ns = start_ns + k * refresh_ns;
+        if (frame_pacer_vsync(&pacer, vsync_ns)) {
+            started |= 1u << k;
+        }
+        if (k == 0) {
+            frame_pacer_frame_done(&pacer, vsync_ns + refresh_ns / 2);
+        }
+        if (k == 4) {
+            frame_pacer_frame_done(&pacer, vsync_ns + 1);
+        }
+    }
+    test_check(
+        started == ((1u << 0) | (1u << 2) | (1u << 6)),
+        "frame pacer starts frames every divisor-th vsync"
+    );
+    test_check(
+        pacer.frames == 2 && pacer.missed == 1 && pacer.skipped == 1,
+        "frame pacer counts missed deadlines and skipped vsyncs"
+    );
+}
+
+static bool test_near(int64_t got, int64_t want) {
+    int64_t error = got > want ? got - want : want - got;
+    return error <= want / 16;
+}
+
+static void test_histogram(void) {
+    static Histogram histogram;
+    histogram_reset(&histogram);
+    test_check(
+        histogram_percentile(&histogram, 0.5) == 0,
+        "histogram percentile of nothing is 0"
+    );
+
+    // 1 us to 10 ms in 1 us steps, so the k-th percentile is k * 100 us
+    for (int64_t i = 1; i <= 10000; i += 1) {
+        histogram_record(&histogram, i * 1000);
+    }
+    test_check(
+        test_near(histogram_percentile(&histogram, 0.5), 5000000) &&
+            test_near(histogram_percentile(&histogram, 0.9), 9000000) &&
+            test_near(histogram_percentile(&histogram, 0.99), 9900000) &&
+            test_near(histogram_percentile(&histogram, 0.01), 100000),
+        "histogram percentiles are within the bucket resolution"
+    );
+    test_check(
+        histogram_percentile(&histogram, 1.0) == 10000000,
+        "histogram percentile 1 is the exact max"
+    );
+}
+
+int main(void) {
+    test_config_select();
+    test_config_cache();
+
+    test_damage();
+    test_surface();
+    test_scale();
+    test_fixed_step();
+    test_scene_advance();
+    test_frame_pacer();
+    test_histogram();
+    if (test_failures > 0) {
+        printf("%d checks failed\n", test_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -16,6 +16,8 @@
  */
 
 #include "android_native_app_glue.h"
+#include "segl_log.h"
+#include "segl_trace.h"
 
 #include <jni.h>
 
@@ -24,17 +26,11 @@
 #include <string.h>
 #include <unistd.h>
 
-#include <android/log.h>
+#define LOGI(...) SEGL_LOG_TAG(ANDROID_LOG_INFO, "threaded_app", __VA_ARGS__)
+#define LOGE(...) SEGL_LOG_TAG(ANDROID_LOG_ERROR, "threaded_app", __VA_ARGS__)
 
-#define LOGI(...) ((void)__android_log_print(ANDROID_LOG_INFO, "threaded_app", __VA_ARGS__))
-#define LOGE(...) ((void)__android_log_print(ANDROID_LOG_ERROR, "threaded_app", __VA_ARGS__))
-
-/* For debug builds, always enable the debug traces in this library */
-#ifndef NDEBUG
-#  define LOGV(...)  ((void)__android_log_print(ANDROID_LOG_VERBOSE, "threaded_app", __VA_ARGS__))
-#else
-#  define LOGV(...)  ((void)0)
-#endif
+/* SEGL_LOG_LEVEL strips the verbose traces from NDEBUG builds */
+#define LOGV(...) SEGL_LOG_TAG(ANDROID_LOG_VERBOSE, "threaded_app", __VA_ARGS__)
 
 static void free_saved_state(struct android_app* android_app) {
     pthread_mutex_lock(&android_app->mutex);
@@ -180,6 +176,7 @@ static void android_app_destroy(struct android_app* android_app) {
 }
 
 static void process_input(struct android_app* app, struct android_poll_source* source) {
+    SEGL_TRACE_BEGIN("process_input");
     AInputEvent* event = NULL;
     while (AInputQueue_getEvent(app->inputQueue, &event) >= 0) {
         LOGV("New input event: type=%d", AInputEvent_getType(event));
@@ -190,13 +187,16 @@ static void process_input(struct android_app* app, struct android_poll_source* s
         if (app->onInputEvent != NULL) handled = app->onInputEvent(app, event);
         AInputQueue_finishEvent(app->inputQueue, event, handled);
     }
+    SEGL_TRACE_END("process_input");
 }
 
 static void process_cmd(struct android_app* app, struct android_poll_source* source) {
+    SEGL_TRACE_BEGIN("process_cmd");
     int8_t cmd = android_app_read_cmd(app);
     android_app_pre_exec_cmd(app, cmd);
     if (app->onAppCmd != NULL) app->onAppCmd(app, cmd);
     android_app_post_exec_cmd(app, cmd);
+    SEGL_TRACE_END("process_cmd");
 }
 
 static void* android_app_entry(void* param) {
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <dlfcn.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "choreographer.h"
+
+// NOTE: frame times are CLOCK_MONOTONIC, but the API 24 callback passes
+// them as a long, which wraps every 4.3 s on 32-bit ABIs; the vsync is
+// the latest time before now with the same low 32 bits
+static int64_t choreographer_unwrap(long frame_time_ns) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t now_ns = (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+    if (sizeof(long) >= sizeof(int64_t)) {
+        return (int64_t)frame_time_ns;
+    }
+    uint32_t behind = (uint32_t)now_ns - (uint32_t)frame_time_ns;
+    return now_ns - (int64_t)behind;
+}
+
+static void choreographer_callback(long frame_time_ns, void *data) {
+    Choreographer *choreographer = data;
+    choreographer->posted = false;
+    choreographer->fn(
+        choreographer_unwrap(frame_time_ns),
+        choreographer->userdata
+    );
+}
+
+static void choreographer_callback64(int64_t frame_time_ns, void *data) {
+    Choreographer *choreographer = data;
+    choreographer->posted = false;
+    choreographer->fn(frame_time_ns, choreographer->userdata);
+}
+
+bool choreographer_load(
+    Choreographer *choreographer,
+    ChoreographerFn fn,
+    void *userdata
+) {
+    *choreographer = (Choreographer){
+        .fn = fn,
+        .userdata = userdata,
+    };
+    void *so_handle = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (so_handle == NULL) {
+        return false;
+    }
+    void *(*get_instance)(void) = (void *(*)(void))dlsym(
+        so_handle,
+        "AChoreographer_getInstance"
+    );
+    choreographer->post = (void (*)(void *, void (*)(long, void *), void *))
+        dlsym(so_handle, "AChoreographer_postFrameCallback");
+    choreographer->post64 = (
+        void (*)(void *, void (*)(int64_t, void *), void *)
+    )dlsym(so_handle, "AChoreographer_postFrameCallback64");
+    if (
+        get_instance == NULL ||
+        (choreographer->post == NULL && choreographer->post64 == NULL)
+    ) {
+        return false;
+    }
+    choreographer->instance = get_instance();
+    return choreographer->instance != NULL;
+}
+
+void choreographer_post(Choreographer *choreographer) {
+    if (choreographer->posted) {
+        return;
+    }
+    choreographer->posted = true;
+    if (choreographer->post64 != NULL) {
+        choreographer->post64(
+            choreographer->instance,
+            choreographer_callback64,
+            choreographer
+        );
+    } else {
+        choreographer->post(
+            choreographer->instance,
+            choreographer_callback,
+            choreographer
+        );
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef CHOREOGRAPHER_H
+#define CHOREOGRAPHER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// AChoreographer, looked up in libandroid.so at runtime since it only
+// exists from API 24 on and the app runs on API 22.
+typedef void (*ChoreographerFn)(int64_t vsync_ns, void *userdata);
+
+typedef struct {
+    void *instance;
+    void (*post)(void *instance, void (*callback)(long, void *), void *data);
+    void (*post64)(
+        void *instance,
+        void (*callback)(int64_t, void *),
+        void *data
+    );
+    ChoreographerFn fn;
+    void *userdata;
+    // a callback is waiting for the next vsync
+    bool posted;
+} Choreographer;
+
+// Binds to the calling thread's looper, which runs the callbacks. Returns
+// false when the device has no AChoreographer.
+bool choreographer_load(
+    Choreographer *choreographer,
+    ChoreographerFn fn,
+    void *userdata
+);
+// Asks for one callback at the next vsync, unless one is already posted.
+void choreographer_post(Choreographer *choreographer);
+
+#endif // CHOREOGRAPHER_H
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdint.h>
+
+#include "fixed_step.h"
+
+void fixed_step_init(
+    FixedStep *step,
+    int64_t step_ns,
+    int max_steps,
+    FixedStepPolicy policy
+) {
+    *step = (FixedStep){
+        .step_ns = step_ns,
+        .max_steps = max_steps,
+        .policy = policy,
+    };
+}
+
+int fixed_step_advance(
+    FixedStep *step,
+    int64_t elapsed_ns,
+    uint64_t *skipped
+) {
+    step->accumulator_ns += elapsed_ns;
+    int64_t steps = step->accumulator_ns / step->step_ns;
+    step->accumulator_ns -= steps * step->step_ns;
+
+    // NOTE: steps that take longer than the time they simulate would
+    // otherwise fall further behind every frame
+    *skipped = 0;
+    if (steps > step->max_steps) {
+        int64_t excess = steps - step->max_steps;
+        if (step->policy == FIXED_STEP_FAST_FORWARD) {
+            *skipped = (uint64_t)excess;
+            step->skipped += (uint64_t)excess;
+        } else {
+            step->dropped_ns += excess * step->step_ns;
+        }
+        steps = step->max_steps;
+    }
+    step->steps += (uint64_t)steps;
+    return (int)steps;
+}
+
+float fixed_step_alpha(const FixedStep *step) {
+    return (float)step->accumulator_ns / (float)step->step_ns;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include <stdint.h>
+
+// Fixed timestep scheduler: the simulation advances in whole steps of
+// step_ns while frames render at whatever rate the display runs, blending
+// the last two simulated states by fixed_step_alpha. Each frame:
+//     steps = fixed_step_advance(&step, frame_elapsed_ns, &skipped)
+//     fast-forward skipped steps at once, if the policy hands any out
+//     run steps simulation steps, keeping the state before the last one
+//     render prev and current blended by fixed_step_alpha(&step)
+// A long stall or a resume from the background owes many more steps than
+// max_steps; the policy decides what becomes of them.
+typedef enum {
+    // drop them, so the simulation falls behind the clock; for simulations
+    // that can only run step by step
+    FIXED_STEP_CLAMP,
+    // hand them to the caller to apply in one go, for simulations with an
+    // O(1) advance by n steps
+    FIXED_STEP_FAST_FORWARD,
+} FixedStepPolicy;
+
+typedef struct {
+    int64_t step_ns;
+    // steps per frame run one by one
+    int max_steps;
+    FixedStepPolicy policy;
+    // time not simulated yet, less than step_ns after each advance
+    int64_t accumulator_ns;
+    uint64_t steps;
+    // steps handed out to fast-forward
+    uint64_t skipped;
+    // time dropped by the clamp
+    int64_t dropped_ns;
+} FixedStep;
+
+void fixed_step_init(
+    FixedStep *step,
+    int64_t step_ns,
+    int max_steps,
+    FixedStepPolicy policy
+);
+// Adds the elapsed time and returns the steps to run, at most max_steps.
+// Steps beyond that go to *skipped under FIXED_STEP_FAST_FORWARD, which
+// then come before the ones returned; *skipped is 0 otherwise.
+int fixed_step_advance(
+    FixedStep *step,
+    int64_t elapsed_ns,
+    uint64_t *skipped
+);
+// How far the unsimulated time reaches into the next step, from 0 to 1.
+float fixed_step_alpha(const FixedStep *step);
+
+#endif // FIXED_STEP_H
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/timerfd.h>
+
+#include "frame_pacer.h"
+
+static int64_t frame_pacer_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+void frame_pacer_init(FramePacer *pacer, int64_t refresh_ns, int divisor) {
+    *pacer = (FramePacer){
+        .divisor = divisor < 1 ? 1 : divisor,
+        .refresh_ns = refresh_ns,
+    };
+}
+
+bool frame_pacer_vsync(FramePacer *pacer, int64_t vsync_ns) {
+    // NOTE: a late callback carries the timestamp of a later vsync, so the
+    // count goes by the time passed; close deltas refine the refresh
+    bool first = pacer->last_vsync_ns == 0;
+    uint64_t before = pacer->vsyncs;
+    if (!first) {
+        int64_t delta = vsync_ns - pacer->last_vsync_ns;
+        if (delta <= 0) {
+            return false;
+        }
+        uint64_t passed = (uint64_t)(
+            (delta + pacer->refresh_ns / 2) / pacer->refresh_ns
+        );
+        if (passed == 1) {
+            pacer->refresh_ns += (delta - pacer->refresh_ns) / 8;
+        }
+        if (passed == 0) {
+            passed = 1;
+        }
+        pacer->vsyncs += passed;
+    }
+    pacer->last_vsync_ns = vsync_ns;
+
+    // NOTE: frames start at the first vsync and whenever the index crosses
+    // a multiple of the divisor
+    uint64_t divisor = (uint64_t)pacer->divisor;
+    if (!first && before / divisor == pacer->vsyncs / divisor) {
+        return false;
+    }
+    if (pacer->frame_pending) {
+        pacer->skipped += 1;
+        return false;
+    }
+    pacer->frame_vsync_ns = vsync_ns;
+    pacer->frame_pending = true;
+    return true;
+}
+
+void frame_pacer_frame_done(FramePacer *pacer, int64_t now_ns) {
+    if (!pacer->frame_pending) {
+        return;
+    }
+    pacer->frame_pending = false;
+    pacer->frames += 1;
+    if (now_ns > frame_pacer_deadline(pacer)) {
+        pacer->missed += 1;
+    }
+}
+
+int64_t frame_pacer_deadline(const FramePacer *pacer) {
+    return pacer->frame_vsync_ns + pacer->refresh_ns * pacer->divisor;
+}
+
+bool frame_timer_open(FrameTimer *timer, int64_t period_ns) {
+    *timer = (FrameTimer){
+        .fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC),
+        .period_ns = period_ns,
+    };
+    return timer->fd >= 0;
+}
+
+void frame_timer_close(FrameTimer *timer) {
+    if (timer->fd >= 0) {
+        close(timer->fd);
+    }
+    timer->fd = -1;
+}
+
+void frame_timer_arm(FrameTimer *timer, bool armed) {
+    struct itimerspec spec = { 0 };
+    if (armed) {
+        int64_t now_ns = frame_pacer_now();
+        timer->start_ns = (now_ns / timer->period_ns + 1) * timer->period_ns;
+        timer->ticks = 0;
+        spec.it_value = (struct timespec){
+            .tv_sec = timer->start_ns / 1000000000L,
+            .tv_nsec = timer->start_ns % 1000000000L,
+        };
+        spec.it_interval = (struct timespec){
+            .tv_sec = timer->period_ns / 1000000000L,
+            .tv_nsec = timer->period_ns % 1000000000L,
+        };
+    }
+    timerfd_settime(timer->fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+int64_t frame_timer_read(FrameTimer *timer) {
+    uint64_t expirations = 0;
+    if (
+        read(timer->fd, &expirations, sizeof(expirations)) !=
+            (ssize_t)sizeof(expirations) ||
+        expirations == 0
+    ) {
+        return 0;
+    }
+    timer->ticks += expirations;
+    return timer->start_ns + (int64_t)(timer->ticks - 1) * timer->period_ns;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Vsync-aligned frame pacing: frames start at the timestamp of every
+// divisor-th vsync, e.g. 60, 30 or 20 fps for 1, 2 or 3 on a 60 Hz panel,
+// and a frame missed its deadline when it is not swapped by the vsync the
+// next frame starts at. Each vsync, from AChoreographer or a FrameTimer:
+//     if (frame_pacer_vsync(&pacer, vsync_ns)) start a frame
+//     ...render and swap...
+//     frame_pacer_frame_done(&pacer, now_ns)
+typedef struct {
+    int divisor;
+    // estimated from the vsync timestamps, starting from a nominal value
+    int64_t refresh_ns;
+    int64_t last_vsync_ns;
+    // index of the last vsync since the first, counting vsyncs whose
+    // callbacks were skipped by a late one
+    uint64_t vsyncs;
+    // the vsync the current frame started at, while it is in flight
+    int64_t frame_vsync_ns;
+    bool frame_pending;
+    uint64_t frames;
+    uint64_t missed;
+    // target vsyncs passed while the previous frame was still in flight
+    uint64_t skipped;
+} FramePacer;
+
+void frame_pacer_init(FramePacer *pacer, int64_t refresh_ns, int divisor);
+// Returns true when the vsync starts a frame.
+bool frame_pacer_vsync(FramePacer *pacer, int64_t vsync_ns);
+// Call once the frame is swapped.
+void frame_pacer_frame_done(FramePacer *pacer, int64_t now_ns);
+// The vsync the current frame should be displayed at.
+int64_t frame_pacer_deadline(const FramePacer *pacer);
+
+// Stand-in vsync source: a CLOCK_MONOTONIC timerfd that fires every
+// period, so pacing runs on a host or on devices without AChoreographer.
+// The fd becomes readable at each vsync and can join a looper or poll.
+typedef struct {
+    int fd;
+    int64_t period_ns;
+    int64_t start_ns;
+    uint64_t ticks;
+} FrameTimer;
+
+// Returns false if the timerfd could not be created.
+bool frame_timer_open(FrameTimer *timer, int64_t period_ns);
+void frame_timer_close(FrameTimer *timer);
+// Arms the timer from the next period boundary, or disarms it.
+void frame_timer_arm(FrameTimer *timer, bool armed);
+// Consumes the expirations and returns the latest vsync timestamp, or 0
+// when none expired.
+int64_t frame_timer_read(FrameTimer *timer);
+
+#endif // FRAME_PACER_H
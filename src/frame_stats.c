@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "frame_stats.h"
+
+#ifdef SEGL_FRAME_STATS
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "histogram.h"
+#include "segl.h"
+#include "segl_log.h"
+
+static const char *const frame_stats_names[FRAME_PHASE_COUNT] = {
+    [FRAME_PHASE_POLL] = "poll",
+    [FRAME_PHASE_ISSUE] = "issue",
+    [FRAME_PHASE_SWAP] = "swap",
+};
+
+static int64_t frame_stats_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+static void *frame_stats_thread(void *userdata) {
+    FrameStats *stats = userdata;
+    Histogram phases[FRAME_PHASE_COUNT];
+    pthread_mutex_lock(&stats->mutex);
+    for (;;) {
+        while (!stats->mailbox_full && !stats->quit) {
+            pthread_cond_wait(&stats->cond, &stats->mutex);
+        }
+        if (stats->quit) {
+            break;
+        }
+        memcpy(phases, stats->mailbox, sizeof(phases));
+        uint64_t dropped = stats->mailbox_dropped;
+        stats->mailbox_full = false;
+        pthread_mutex_unlock(&stats->mutex);
+
+        for (int i = 0; i < FRAME_PHASE_COUNT; i += 1) {
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "%s over %llu frames: p50 %lld p90 %lld p99 %lld "
+                "max %lld us (%llu reports dropped)",
+                frame_stats_names[i],
+                (unsigned long long)phases[i].total,
+                (long long)(histogram_percentile(&phases[i], 0.5) / 1000),
+                (long long)(histogram_percentile(&phases[i], 0.9) / 1000),
+                (long long)(histogram_percentile(&phases[i], 0.99) / 1000),
+                (long long)(phases[i].max / 1000),
+                (unsigned long long)dropped
+            );
+        }
+
+        pthread_mutex_lock(&stats->mutex);
+    }
+    pthread_mutex_unlock(&stats->mutex);
+    return NULL;
+}
+
+bool frame_stats_start(FrameStats *stats, uint64_t report_frames) {
+    memset(stats, 0, sizeof(*stats));
+    stats->report_frames = report_frames;
+    pthread_mutex_init(&stats->mutex, NULL);
+    pthread_cond_init(&stats->cond, NULL);
+    if (pthread_create(&stats->thread, NULL, frame_stats_thread, stats) != 0) {
+        pthread_cond_destroy(&stats->cond);
+        pthread_mutex_destroy(&stats->mutex);
+        stats->report_frames = 0;
+        return false;
+    }
+    return true;
+}
+
+void frame_stats_stop(FrameStats *stats) {
+    if (stats->report_frames == 0) {
+        return;
+    }
+    pthread_mutex_lock(&stats->mutex);
+    stats->quit = true;
+    pthread_cond_signal(&stats->cond);
+    pthread_mutex_unlock(&stats->mutex);
+    pthread_join(stats->thread, NULL);
+    pthread_cond_destroy(&stats->cond);
+    pthread_mutex_destroy(&stats->mutex);
+    stats->report_frames = 0;
+}
+
+void frame_stats_begin(FrameStats *stats, FramePhase phase) {
+    stats->starts[phase] = frame_stats_now();
+}
+
+void frame_stats_end(FrameStats *stats, FramePhase phase) {
+    histogram_record(
+        &stats->phases[phase],
+        frame_stats_now() - stats->starts[phase]
+    );
+}
+
+void frame_stats_frame(FrameStats *stats) {
+    stats->frames += 1;
+    if (
+        stats->report_frames == 0 ||
+        stats->frames % stats->report_frames != 0
+    ) {
+        return;
+    }
+    if (pthread_mutex_trylock(&stats->mutex) != 0) {
+        stats->dropped += 1;
+        return;
+    }
+    if (stats->mailbox_full) {
+        stats->dropped += 1;
+    } else {
+        memcpy(stats->mailbox, stats->phases, sizeof(stats->mailbox));
+        stats->mailbox_dropped = stats->dropped;
+        stats->mailbox_full = true;
+        pthread_cond_signal(&stats->cond);
+    }
+    pthread_mutex_unlock(&stats->mutex);
+    for (int i = 0; i < FRAME_PHASE_COUNT; i += 1) {
+        histogram_reset(&stats->phases[i]);
+    }
+}
+
+#endif // SEGL_FRAME_STATS
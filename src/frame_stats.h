@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-phase frame time histograms, built only with -DSEGL_FRAME_STATS;
+// otherwise the FRAME_STATS_* macros expand to nothing and none of this
+// is compiled. Each phase runs between FRAME_STATS_BEGIN and
+// FRAME_STATS_END, and FRAME_STATS_FRAME hands the histograms to a
+// reporter thread every report_frames frames.
+typedef enum {
+    // looper events, including any wait for a command or vsync
+    FRAME_PHASE_POLL,
+    // simulation and GL command issue up to the swap
+    FRAME_PHASE_ISSUE,
+    FRAME_PHASE_SWAP,
+    FRAME_PHASE_COUNT,
+} FramePhase;
+
+#ifdef SEGL_FRAME_STATS
+
+#include <pthread.h>
+
+#include "histogram.h"
+
+typedef struct {
+    Histogram phases[FRAME_PHASE_COUNT];
+    int64_t starts[FRAME_PHASE_COUNT];
+    uint64_t frames;
+    uint64_t report_frames;
+
+    // NOTE: the render thread only ever trylocks the mailbox, so a report
+    // that would wait for the reporter is dropped and counted instead
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    Histogram mailbox[FRAME_PHASE_COUNT];
+    uint64_t mailbox_dropped;
+    bool mailbox_full;
+    bool quit;
+    // reports dropped so far, owned by the render thread
+    uint64_t dropped;
+} FrameStats;
+
+// Starts the reporter thread. Returns false if it could not.
+bool frame_stats_start(FrameStats *stats, uint64_t report_frames);
+void frame_stats_stop(FrameStats *stats);
+void frame_stats_begin(FrameStats *stats, FramePhase phase);
+void frame_stats_end(FrameStats *stats, FramePhase phase);
+void frame_stats_frame(FrameStats *stats);
+
+#define FRAME_STATS_START(stats, report_frames) \
+    frame_stats_start((stats), (report_frames))
+#define FRAME_STATS_STOP(stats) frame_stats_stop(stats)
+#define FRAME_STATS_BEGIN(stats, phase) frame_stats_begin((stats), (phase))
+#define FRAME_STATS_END(stats, phase) frame_stats_end((stats), (phase))
+#define FRAME_STATS_FRAME(stats) frame_stats_frame(stats)
+
+#else // SEGL_FRAME_STATS
+
+#define FRAME_STATS_START(stats, report_frames) ((void)0)
+#define FRAME_STATS_STOP(stats) ((void)0)
+#define FRAME_STATS_BEGIN(stats, phase) ((void)0)
+#define FRAME_STATS_END(stats, phase) ((void)0)
+#define FRAME_STATS_FRAME(stats) ((void)0)
+
+#endif // SEGL_FRAME_STATS
+
+#endif // FRAME_STATS_H
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "histogram.h"
+
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+
+static int histogram_bucket(uint64_t value) {
+    if (value < HISTOGRAM_SUB_COUNT) {
+        return (int)value;
+    }
+    int shift = 63 - __builtin_clzll(value) - HISTOGRAM_SUB_BITS;
+    return ((shift + 1) << HISTOGRAM_SUB_BITS) +
+        (int)((value >> shift) - HISTOGRAM_SUB_COUNT);
+}
+
+static uint64_t histogram_bucket_low(int bucket) {
+    if (bucket < HISTOGRAM_SUB_COUNT) {
+        return (uint64_t)bucket;
+    }
+    int shift = (bucket >> HISTOGRAM_SUB_BITS) - 1;
+    uint64_t sub = (uint64_t)(bucket & (HISTOGRAM_SUB_COUNT - 1));
+    return (HISTOGRAM_SUB_COUNT + sub) << shift;
+}
+
+void histogram_reset(Histogram *histogram) {
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+void histogram_record(Histogram *histogram, int64_t value) {
+    if (value < 0) {
+        value = 0;
+    }
+    histogram->counts[histogram_bucket((uint64_t)value)] += 1;
+    histogram->total += 1;
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+int64_t histogram_percentile(const Histogram *histogram, double p) {
+    if (histogram->total == 0) {
+        return 0;
+    }
+    if (p >= 1.0) {
+        return histogram->max;
+    }
+    uint64_t rank = (uint64_t)(p * (double)histogram->total) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i += 1) {
+        seen += histogram->counts[i];
+        if (seen >= rank) {
+            uint64_t low = histogram_bucket_low(i);
+            uint64_t high = i + 1 < HISTOGRAM_BUCKETS ?
+                histogram_bucket_low(i + 1) :
+                (uint64_t)histogram->max;
+            int64_t middle = (int64_t)(low + (high - low) / 2);
+            return middle < histogram->max ? middle : histogram->max;
+        }
+    }
+    return histogram->max;
+}
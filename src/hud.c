@@ -0,0 +1,559 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "hud.h"
+#include "segl.h"
+#include "segl_log.h"
+
+// time between refreshes of the text
+#define HUD_TEXT_NS (250L * 1000L * 1000L)
+
+// 5x7 glyphs of ' ' to 'Z', a byte per column with the top row in bit 0;
+// lowercase letters are drawn as uppercase and anything else as '?'
+#define HUD_GLYPH_FIRST ' '
+#define HUD_GLYPH_LAST 'Z'
+static const uint8_t hud_font[HUD_GLYPH_LAST - HUD_GLYPH_FIRST + 1][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5f, 0x00, 0x00 },
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7f, 0x14, 0x7f, 0x14 },
+    { 0x24, 0x2a, 0x7f, 0x2a, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 },
+    { 0x00, 0x1c, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1c, 0x00 },
+    { 0x08, 0x2a, 0x1c, 0x2a, 0x08 }, { 0x08, 0x08, 0x3e, 0x08, 0x08 },
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 },
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x3e, 0x51, 0x49, 0x45, 0x3e }, { 0x00, 0x42, 0x7f, 0x40, 0x00 },
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4b, 0x31 },
+    { 0x18, 0x14, 0x12, 0x7f, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 },
+    { 0x3c, 0x4a, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1e },
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 },
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 },
+    { 0x32, 0x49, 0x79, 0x41, 0x3e }, { 0x7e, 0x11, 0x11, 0x11, 0x7e },
+    { 0x7f, 0x49, 0x49, 0x49, 0x36 }, { 0x3e, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7f, 0x41, 0x41, 0x22, 0x1c }, { 0x7f, 0x49, 0x49, 0x49, 0x41 },
+    { 0x7f, 0x09, 0x09, 0x09, 0x01 }, { 0x3e, 0x41, 0x49, 0x49, 0x7a },
+    { 0x7f, 0x08, 0x08, 0x08, 0x7f }, { 0x00, 0x41, 0x7f, 0x41, 0x00 },
+    { 0x20, 0x40, 0x41, 0x3f, 0x01 }, { 0x7f, 0x08, 0x14, 0x22, 0x41 },
+    { 0x7f, 0x40, 0x40, 0x40, 0x40 }, { 0x7f, 0x02, 0x0c, 0x02, 0x7f },
+    { 0x7f, 0x04, 0x08, 0x10, 0x7f }, { 0x3e, 0x41, 0x41, 0x41, 0x3e },
+    { 0x7f, 0x09, 0x09, 0x09, 0x06 }, { 0x3e, 0x41, 0x51, 0x21, 0x5e },
+    { 0x7f, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+    { 0x01, 0x01, 0x7f, 0x01, 0x01 }, { 0x3f, 0x40, 0x40, 0x40, 0x3f },
+    { 0x1f, 0x20, 0x40, 0x20, 0x1f }, { 0x3f, 0x40, 0x38, 0x40, 0x3f },
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 },
+    { 0x61, 0x51, 0x49, 0x45, 0x43 },
+};
+
+// The atlas holds every glyph in a 6x8 cell, spacing included, followed by
+// one solid cell for the panel and the graph.
+#define HUD_CELL_WIDTH 6
+#define HUD_CELL_HEIGHT 8
+#define HUD_LINE_HEIGHT 10
+#define HUD_ATLAS_COLUMNS 16
+#define HUD_ATLAS_ROWS 4
+#define HUD_ATLAS_WIDTH (HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH)
+#define HUD_ATLAS_HEIGHT (HUD_ATLAS_ROWS * HUD_CELL_HEIGHT)
+#define HUD_SOLID_CELL (HUD_GLYPH_LAST - HUD_GLYPH_FIRST + 1)
+// graph height in font pixels; a frame at the budget reaches half of it
+#define HUD_GRAPH_HEIGHT 32
+
+static const char *const hud_phase_names[FRAME_PHASE_COUNT] = {
+    [FRAME_PHASE_POLL] = "POLL",
+    [FRAME_PHASE_ISSUE] = "ISSUE",
+    [FRAME_PHASE_SWAP] = "SWAP",
+};
+
+static const uint8_t hud_panel_color[4] = { 0, 0, 0, 160 };
+static const uint8_t hud_text_color[4] = { 255, 255, 255, 255 };
+static const uint8_t hud_budget_color[4] = { 255, 220, 0, 255 };
+static const uint8_t hud_fast_color[4] = { 64, 220, 96, 255 };
+static const uint8_t hud_slow_color[4] = { 240, 64, 48, 255 };
+
+static const char hud_vertex_source[] =
+    "uniform vec2 u_scale;\n"
+    "attribute vec2 a_position;\n"
+    "attribute vec2 a_uv;\n"
+    "attribute vec4 a_color;\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    v_uv = a_uv;\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = vec4(\n"
+    "        a_position * u_scale + vec2(-1.0, 1.0),\n"
+    "        0.0,\n"
+    "        1.0\n"
+    "    );\n"
+    "}\n";
+
+static const char hud_fragment_source[] =
+    "precision mediump float;\n"
+    "uniform sampler2D u_atlas;\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    float coverage = texture2D(u_atlas, v_uv).a;\n"
+    "    gl_FragColor = vec4(v_color.rgb, v_color.a * coverage);\n"
+    "}\n";
+
+enum {
+    HUD_ATTRIB_POSITION,
+    HUD_ATTRIB_UV,
+    HUD_ATTRIB_COLOR,
+};
+
+void hud_init(Hud *hud, int64_t budget_ns) {
+    memset(hud, 0, sizeof(*hud));
+    hud->budget_ns = budget_ns;
+}
+
+void hud_toggle(Hud *hud) {
+    hud->visible = !hud->visible;
+    memset(hud->graph_ms, 0, sizeof(hud->graph_ms));
+    memset(hud->lines, 0, sizeof(hud->lines));
+    // NOTE: sums from before a hide would land in the first interval after
+    // the show, which only starts timing then
+    hud->text_ns = 0;
+    hud->sum_frame_ns = 0;
+    memset(hud->sum_phase_ns, 0, sizeof(hud->sum_phase_ns));
+    hud->sum_frames = 0;
+}
+
+static double hud_rss_mb(void) {
+    char buf[128];
+    int fd = open("/proc/self/statm", O_RDONLY);
+    if (fd < 0) {
+        return 0.0;
+    }
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    long long pages = 0;
+    if (len <= 0) {
+        return 0.0;
+    }
+    buf[len] = '\0';
+    if (sscanf(buf, "%*s %lld", &pages) != 1) {
+        return 0.0;
+    }
+    return (double)pages * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+static void hud_text_refresh(Hud *hud, int64_t elapsed_ns) {
+    double frames = (double)hud->sum_frames;
+    snprintf(
+        hud->lines[0],
+        HUD_LINE_LEN,
+        "FPS %5.1f %6.2f MS",
+        frames * 1e9 / (double)elapsed_ns,
+        (double)hud->sum_frame_ns / frames / 1e6
+    );
+    for (int i = 0; i < FRAME_PHASE_COUNT; i += 1) {
+        snprintf(
+            hud->lines[1 + i],
+            HUD_LINE_LEN,
+            "%-5s %6.2f MS",
+            hud_phase_names[i],
+            (double)hud->sum_phase_ns[i] / frames / 1e6
+        );
+    }
+    snprintf(
+        hud->lines[1 + FRAME_PHASE_COUNT],
+        HUD_LINE_LEN,
+        "RSS %6.1f MB",
+        hud_rss_mb()
+    );
+}
+
+void hud_frame(Hud *hud, const HudFrame *frame, int64_t now_ns) {
+    if (!hud->visible) {
+        return;
+    }
+    hud->graph_ms[hud->graph_next] = (float)frame->frame_ns / 1e6f;
+    hud->graph_next = (hud->graph_next + 1) % HUD_GRAPH_FRAMES;
+
+    if (hud->text_ns == 0) {
+        hud->text_ns = now_ns;
+        return;
+    }
+    hud->sum_frame_ns += frame->frame_ns;
+    for (int i = 0; i < FRAME_PHASE_COUNT; i += 1) {
+        hud->sum_phase_ns[i] += frame->phase_ns[i];
+    }
+    hud->sum_frames += 1;
+    if (now_ns - hud->text_ns < HUD_TEXT_NS) {
+        return;
+    }
+    hud_text_refresh(hud, now_ns - hud->text_ns);
+    hud->text_ns = now_ns;
+    hud->sum_frame_ns = 0;
+    memset(hud->sum_phase_ns, 0, sizeof(hud->sum_phase_ns));
+    hud->sum_frames = 0;
+}
+
+static GLuint hud_shader_load(
+    GLenum type,
+    const char *source,
+    const SGlVtable *sgl_vtable
+) {
+    GLuint shader = sgl_vtable->CreateShader(type);
+    sgl_vtable->ShaderSource(shader, 1, &source, NULL);
+    sgl_vtable->CompileShader(shader);
+    GLint compiled = GL_FALSE;
+    sgl_vtable->GetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[512] = { 0 };
+        sgl_vtable->GetShaderInfoLog(shader, sizeof(log), NULL, log);
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to compile HUD shader: %s",
+            log
+        );
+        sgl_vtable->DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static bool hud_program_load(Hud *hud, const SGlVtable *sgl_vtable) {
+    GLuint vertex = hud_shader_load(
+        GL_VERTEX_SHADER,
+        hud_vertex_source,
+        sgl_vtable
+    );
+    GLuint fragment = hud_shader_load(
+        GL_FRAGMENT_SHADER,
+        hud_fragment_source,
+        sgl_vtable
+    );
+    if (vertex == 0 || fragment == 0) {
+        sgl_vtable->DeleteShader(vertex);
+        sgl_vtable->DeleteShader(fragment);
+        return false;
+    }
+
+    hud->program = sgl_vtable->CreateProgram();
+    sgl_vtable->AttachShader(hud->program, vertex);
+    sgl_vtable->AttachShader(hud->program, fragment);
+    sgl_vtable->BindAttribLocation(
+        hud->program,
+        HUD_ATTRIB_POSITION,
+        "a_position"
+    );
+    sgl_vtable->BindAttribLocation(hud->program, HUD_ATTRIB_UV, "a_uv");
+    sgl_vtable->BindAttribLocation(hud->program, HUD_ATTRIB_COLOR, "a_color");
+    sgl_vtable->LinkProgram(hud->program);
+    // NOTE: the program keeps the shaders alive for as long as it needs them
+    sgl_vtable->DeleteShader(vertex);
+    sgl_vtable->DeleteShader(fragment);
+
+    GLint linked = GL_FALSE;
+    sgl_vtable->GetProgramiv(hud->program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[512] = { 0 };
+        sgl_vtable->GetProgramInfoLog(hud->program, sizeof(log), NULL, log);
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to link HUD program: %s",
+            log
+        );
+        sgl_vtable->DeleteProgram(hud->program);
+        hud->program = 0;
+        return false;
+    }
+    hud->scale_location = sgl_vtable->GetUniformLocation(
+        hud->program,
+        "u_scale"
+    );
+    return true;
+}
+
+static void hud_atlas_load(Hud *hud, const SGlVtable *sgl_vtable) {
+    static uint8_t pixels[HUD_ATLAS_HEIGHT][HUD_ATLAS_WIDTH];
+    memset(pixels, 0, sizeof(pixels));
+    for (int cell = 0; cell <= HUD_SOLID_CELL; cell += 1) {
+        int left = cell % HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH;
+        int top = cell / HUD_ATLAS_COLUMNS * HUD_CELL_HEIGHT;
+        for (int x = 0; x < HUD_CELL_WIDTH; x += 1) {
+            for (int y = 0; y < HUD_CELL_HEIGHT; y += 1) {
+                bool set = cell == HUD_SOLID_CELL || (
+                    x < 5 && y < 7 && (hud_font[cell][x] >> y & 1) != 0
+                );
+                pixels[top + y][left + x] = set ? 255 : 0;
+            }
+        }
+    }
+
+    sgl_vtable->GenTextures(1, &hud->texture);
+    sgl_vtable->BindTexture(GL_TEXTURE_2D, hud->texture);
+    // NOTE: nearest filtering at whole multiples of the font size keeps
+    // the glyphs sharp, and clamping lets the atlas width be no power of 2
+    sgl_vtable->TexParameteri(
+        GL_TEXTURE_2D,
+        GL_TEXTURE_MIN_FILTER,
+        GL_NEAREST
+    );
+    sgl_vtable->TexParameteri(
+        GL_TEXTURE_2D,
+        GL_TEXTURE_MAG_FILTER,
+        GL_NEAREST
+    );
+    sgl_vtable->TexParameteri(
+        GL_TEXTURE_2D,
+        GL_TEXTURE_WRAP_S,
+        GL_CLAMP_TO_EDGE
+    );
+    sgl_vtable->TexParameteri(
+        GL_TEXTURE_2D,
+        GL_TEXTURE_WRAP_T,
+        GL_CLAMP_TO_EDGE
+    );
+    sgl_vtable->PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    sgl_vtable->TexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_ALPHA,
+        HUD_ATLAS_WIDTH,
+        HUD_ATLAS_HEIGHT,
+        0,
+        GL_ALPHA,
+        GL_UNSIGNED_BYTE,
+        pixels
+    );
+}
+
+static bool hud_load(Hud *hud, const SGlVtable *sgl_vtable) {
+    if (!hud_program_load(hud, sgl_vtable)) {
+        return false;
+    }
+    hud_atlas_load(hud, sgl_vtable);
+    sgl_vtable->GenBuffers(1, &hud->buffer);
+    hud->loaded = true;
+    return true;
+}
+
+void hud_context_lost(Hud *hud) {
+    hud->loaded = false;
+    hud->program = 0;
+    hud->texture = 0;
+    hud->buffer = 0;
+}
+
+static void hud_quad(
+    Hud *hud,
+    float x0,
+    float y0,
+    float x1,
+    float y1,
+    int cell,
+    const uint8_t *color
+) {
+    if (hud->nvertices + 6 > HUD_MAX_QUADS * 6) {
+        return;
+    }
+    float u0 = (float)(cell % HUD_ATLAS_COLUMNS * HUD_CELL_WIDTH) /
+        HUD_ATLAS_WIDTH;
+    float v0 = (float)(cell / HUD_ATLAS_COLUMNS * HUD_CELL_HEIGHT) /
+        HUD_ATLAS_HEIGHT;
+    float u1 = u0 + (float)HUD_CELL_WIDTH / HUD_ATLAS_WIDTH;
+    float v1 = v0 + (float)HUD_CELL_HEIGHT / HUD_ATLAS_HEIGHT;
+    if (cell == HUD_SOLID_CELL) {
+        // NOTE: the middle of the solid cell, so no edge texel bleeds in
+        u0 = u1 = (u0 + u1) * 0.5f;
+        v0 = v1 = (v0 + v1) * 0.5f;
+    }
+    const HudVertex corners[6] = {
+        { x0, y0, u0, v0, { color[0], color[1], color[2], color[3] } },
+        { x0, y1, u0, v1, { color[0], color[1], color[2], color[3] } },
+        { x1, y0, u1, v0, { color[0], color[1], color[2], color[3] } },
+        { x1, y0, u1, v0, { color[0], color[1], color[2], color[3] } },
+        { x0, y1, u0, v1, { color[0], color[1], color[2], color[3] } },
+        { x1, y1, u1, v1, { color[0], color[1], color[2], color[3] } },
+    };
+    memcpy(&hud->vertices[hud->nvertices], corners, sizeof(corners));
+    hud->nvertices += 6;
+}
+
+static void hud_text(Hud *hud, float x, float y, float px, const char *text) {
+    for (; *text != '\0'; text += 1, x += HUD_CELL_WIDTH * px) {
+        char c = *text;
+        if (c >= 'a' && c <= 'z') {
+            c = (char)(c - 'a' + 'A');
+        }
+        if (c == ' ') {
+            continue;
+        }
+        if (c < HUD_GLYPH_FIRST || c > HUD_GLYPH_LAST) {
+            c = '?';
+        }
+        hud_quad(
+            hud,
+            x,
+            y,
+            x + HUD_CELL_WIDTH * px,
+            y + HUD_CELL_HEIGHT * px,
+            c - HUD_GLYPH_FIRST,
+            hud_text_color
+        );
+    }
+}
+
+// Fills the vertices of everything the HUD shows, at x, y in pixels from
+// the top left with font pixels of px pixels.
+static void hud_layout(Hud *hud, float x, float y, float px) {
+    hud->nvertices = 0;
+    float margin = 4.0f * px;
+    float graph_top = y + margin + HUD_LINES * HUD_LINE_HEIGHT * px;
+    float graph_bottom = graph_top + HUD_GRAPH_HEIGHT * px;
+    size_t columns = HUD_GRAPH_FRAMES / HUD_CELL_WIDTH;
+    for (int i = 0; i < HUD_LINES; i += 1) {
+        size_t len = strlen(hud->lines[i]);
+        columns = len > columns ? len : columns;
+    }
+    hud_quad(
+        hud,
+        x,
+        y,
+        x + (float)columns * HUD_CELL_WIDTH * px + 2.0f * margin,
+        graph_bottom + margin,
+        HUD_SOLID_CELL,
+        hud_panel_color
+    );
+
+    for (int i = 0; i < HUD_LINES; i += 1) {
+        hud_text(
+            hud,
+            x + margin,
+            y + margin + (float)(i * HUD_LINE_HEIGHT) * px,
+            px,
+            hud->lines[i]
+        );
+    }
+
+    // NOTE: oldest frame on the left; the budget is at half height, so
+    // anything over it stands out and up to twice the budget still fits
+    float budget_ms = (float)hud->budget_ns / 1e6f;
+    float graph_height = HUD_GRAPH_HEIGHT * px;
+    for (int i = 0; i < HUD_GRAPH_FRAMES; i += 1) {
+        float ms = hud->graph_ms[(hud->graph_next + i) % HUD_GRAPH_FRAMES];
+        float height = ms / (2.0f * budget_ms) * graph_height;
+        height = height > graph_height ? graph_height : height;
+        float left = x + margin + (float)i * px;
+        hud_quad(
+            hud,
+            left,
+            graph_bottom - height,
+            left + px,
+            graph_bottom,
+            HUD_SOLID_CELL,
+            ms > budget_ms ? hud_slow_color : hud_fast_color
+        );
+    }
+    float budget_y = graph_bottom - graph_height * 0.5f;
+    hud_quad(
+        hud,
+        x + margin,
+        budget_y,
+        x + margin + HUD_GRAPH_FRAMES * px,
+        budget_y + px,
+        HUD_SOLID_CELL,
+        hud_budget_color
+    );
+}
+
+void hud_draw(
+    Hud *hud,
+    const SEglRect *area,
+    int32_t width,
+    int32_t height,
+    const SGlVtable *sgl_vtable
+) {
+    if (!hud->visible || width <= 0 || height <= 0) {
+        return;
+    }
+    if (!hud->loaded && !hud_load(hud, sgl_vtable)) {
+        hud->visible = false;
+        return;
+    }
+
+    // NOTE: whole screen pixels per font pixel, about 270 font pixels
+    // across the short side of the surface
+    int32_t px = (width < height ? width : height) / 270;
+    px = px < 1 ? 1 : px;
+    hud_layout(
+        hud,
+        (float)area->x,
+        (float)(height - area->y - area->height),
+        (float)px
+    );
+
+    sgl_vtable->UseProgram(hud->program);
+    sgl_vtable->Uniform2f(hud->scale_location, 2.0f / width, -2.0f / height);
+    sgl_vtable->BindTexture(GL_TEXTURE_2D, hud->texture);
+    sgl_vtable->BindBuffer(GL_ARRAY_BUFFER, hud->buffer);
+    // NOTE: respecifying the whole store first orphans the one the GPU
+    // may still read from the last frame instead of waiting for it
+    sgl_vtable->BufferData(
+        GL_ARRAY_BUFFER,
+        sizeof(hud->vertices),
+        NULL,
+        GL_STREAM_DRAW
+    );
+    sgl_vtable->BufferSubData(
+        GL_ARRAY_BUFFER,
+        0,
+        hud->nvertices * sizeof(HudVertex),
+        hud->vertices
+    );
+    sgl_vtable->VertexAttribPointer(
+        HUD_ATTRIB_POSITION,
+        2,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(HudVertex),
+        (const void *)offsetof(HudVertex, x)
+    );
+    sgl_vtable->VertexAttribPointer(
+        HUD_ATTRIB_UV,
+        2,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(HudVertex),
+        (const void *)offsetof(HudVertex, u)
+    );
+    sgl_vtable->VertexAttribPointer(
+        HUD_ATTRIB_COLOR,
+        4,
+        GL_UNSIGNED_BYTE,
+        GL_TRUE,
+        sizeof(HudVertex),
+        (const void *)offsetof(HudVertex, color)
+    );
+    sgl_vtable->EnableVertexAttribArray(HUD_ATTRIB_POSITION);
+    sgl_vtable->EnableVertexAttribArray(HUD_ATTRIB_UV);
+    sgl_vtable->EnableVertexAttribArray(HUD_ATTRIB_COLOR);
+    sgl_vtable->Enable(GL_BLEND);
+    sgl_vtable->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    sgl_vtable->DrawArrays(GL_TRIANGLES, 0, (GLsizei)hud->nvertices);
+    sgl_vtable->Disable(GL_BLEND);
+}
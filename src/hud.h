@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "frame_stats.h"
+#include "segl.h"
+
+// frames in the frame time graph
+#define HUD_GRAPH_FRAMES 120
+// quads of text, graph bars and the panel behind them
+#define HUD_MAX_QUADS 512
+#define HUD_LINES 5
+#define HUD_LINE_LEN 32
+
+typedef struct {
+    float x;
+    float y;
+    float u;
+    float v;
+    uint8_t color[4];
+} HudVertex;
+
+// Times of one frame, from the end of the previous swap to the end of its
+// own.
+typedef struct {
+    int64_t frame_ns;
+    int64_t phase_ns[FRAME_PHASE_COUNT];
+} HudFrame;
+
+// On-screen performance overlay: frame rate, a graph of recent frame times
+// against the budget, the time of each frame phase and resident memory.
+// Text comes from a 5x7 font baked into the source, and everything is
+// drawn from one vertex buffer with one draw call. The GL objects are
+// created on the first draw after hud_toggle shows it, in the context
+// current then.
+typedef struct {
+    bool visible;
+    bool loaded;
+    GLuint program;
+    GLuint texture;
+    GLuint buffer;
+    GLint scale_location;
+
+    int64_t budget_ns;
+    float graph_ms[HUD_GRAPH_FRAMES];
+    uint32_t graph_next;
+
+    // frames since the text was last refreshed, at text_ns
+    int64_t text_ns;
+    int64_t sum_frame_ns;
+    int64_t sum_phase_ns[FRAME_PHASE_COUNT];
+    uint32_t sum_frames;
+    char lines[HUD_LINES][HUD_LINE_LEN];
+
+    HudVertex vertices[HUD_MAX_QUADS * 6];
+    uint32_t nvertices;
+} Hud;
+
+void hud_init(Hud *hud, int64_t budget_ns);
+void hud_toggle(Hud *hud);
+// Adds a frame to the graph and the averages, refreshing the text a few
+// times a second. Does nothing while hidden.
+void hud_frame(Hud *hud, const HudFrame *frame, int64_t now_ns);
+// Draws over the top left corner of area, in surface pixels with a
+// bottom-left origin like SEglSurfaceState.content, of a width x height
+// viewport. Does nothing while hidden.
+void hud_draw(
+    Hud *hud,
+    const SEglRect *area,
+    int32_t width,
+    int32_t height,
+    const SGlVtable *sgl_vtable
+);
+// Forgets the GL objects, which go with a lost or destroyed context; the
+// next draw creates them again.
+void hud_context_lost(Hud *hud);
+
+#endif // HUD_H
@@ -13,2275 +13,898 @@
 // IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#include <math.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
-#include <EGL/egl.h>
-#include <GLES2/gl2.h>
-
-#include <dlfcn.h>
-
-#include <android/native_window.h>
-#include <android/log.h>
-
-#include "android_native_app_glue.h"
-
-#define SEGL_ANDROID_LOG_ID "SEGLAPP"
-
-#define TIMESTEP 16L * 1000L * 1000L
-
-#define countof(x) (sizeof(x) / (sizeof((x)[0])))
-
-typedef struct android_app AndroidApp;
-typedef struct android_poll_source AndroidPollSource;
-
-typedef struct timespec TimeSpec;
-
-typedef struct {
-    PFNEGLCHOOSECONFIGPROC ChooseConfig;
-    PFNEGLCOPYBUFFERSPROC CopyBuffers;
-    PFNEGLCREATECONTEXTPROC CreateContext;
-    PFNEGLCREATEPBUFFERSURFACEPROC CreatePbufferSurface;
-    PFNEGLCREATEPIXMAPSURFACEPROC CreatePixmapSurface;
-    PFNEGLCREATEWINDOWSURFACEPROC CreateWindowSurface;
-    PFNEGLDESTROYCONTEXTPROC DestroyContext;
-    PFNEGLDESTROYSURFACEPROC DestroySurface;
-    PFNEGLGETCONFIGATTRIBPROC GetConfigAttrib;
-    PFNEGLGETCONFIGSPROC GetConfigs;
-    PFNEGLGETCURRENTDISPLAYPROC GetCurrentDisplay;
-    PFNEGLGETCURRENTSURFACEPROC GetCurrentSurface;
-    PFNEGLGETDISPLAYPROC GetDisplay;
-    PFNEGLGETERRORPROC GetError;
-    PFNEGLGETPROCADDRESSPROC GetProcAddress;
-    PFNEGLINITIALIZEPROC Initialize;
-    PFNEGLMAKECURRENTPROC MakeCurrent;
-    PFNEGLQUERYCONTEXTPROC QueryContext;
-    PFNEGLQUERYSTRINGPROC QueryString;
-    PFNEGLQUERYSURFACEPROC QuerySurface;
-    PFNEGLSWAPBUFFERSPROC SwapBuffers;
-    PFNEGLTERMINATEPROC Terminate;
-    PFNEGLWAITGLPROC WaitGL;
-    PFNEGLWAITNATIVEPROC WaitNative;
-} SEglVtable;
-
-static SEglVtable segl_vtable_load(void) {
-    void *so_handle = dlopen("libEGL.so", RTLD_LAZY | RTLD_LOCAL);
-    if (so_handle == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            "SEGLAP",
-            "failed to load libEGL.so: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-
-    SEglVtable vtable = { 0 };
-
-    vtable.ChooseConfig = dlsym(so_handle, "eglChooseConfig");
-    if (vtable.ChooseConfig == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglChooseConfig: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.CopyBuffers = dlsym(so_handle, "eglCopyBuffers");
-    if (vtable.CopyBuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglCopyBuffers: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.CreateContext = dlsym(so_handle, "eglCreateContext");
-    if (vtable.CreateContext == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglCreateContext: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.CreatePbufferSurface = dlsym(so_handle, "eglCreatePbufferSurface");
-    if (vtable.CreatePbufferSurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglCreatePbufferSu: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.CreatePixmapSurface = dlsym(so_handle, "eglCreatePixmapSurface");
-    if (vtable.CreatePixmapSurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglCreatePixmapSurf: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.CreateWindowSurface = dlsym(so_handle, "eglCreateWindowSurface");
-    if (vtable.CreateWindowSurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglCreateWindowSurf: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.DestroyContext = dlsym(so_handle, "eglDestroyContext");
-    if (vtable.DestroyContext == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglDestroyContext: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.DestroySurface = dlsym(so_handle, "eglDestroySurface");
-    if (vtable.DestroySurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglDestroySurface: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetConfigAttrib = dlsym(so_handle, "eglGetConfigAttrib");
-    if (vtable.GetConfigAttrib == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetConfigAttrib: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetConfigs = dlsym(so_handle, "eglGetConfigs");
-    if (vtable.GetConfigs == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetConfigs: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetCurrentDisplay = dlsym(so_handle, "eglGetCurrentDisplay");
-    if (vtable.GetCurrentDisplay == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetCurrentDisplay: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetCurrentSurface = dlsym(so_handle, "eglGetCurrentSurface");
-    if (vtable.GetCurrentSurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetCurrentSurface: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetDisplay = dlsym(so_handle, "eglGetDisplay");
-    if (vtable.GetDisplay == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetDisplay: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetError = dlsym(so_handle, "eglGetError");
-    if (vtable.GetError == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetError: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.GetProcAddress = dlsym(so_handle, "eglGetProcAddress");
-    if (vtable.GetProcAddress == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglGetProcAddress: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.Initialize = dlsym(so_handle, "eglInitialize");
-    if (vtable.Initialize == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglInitialize: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.MakeCurrent = dlsym(so_handle, "eglMakeCurrent");
-    if (vtable.MakeCurrent == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglMakeCurrent: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.QueryContext = dlsym(so_handle, "eglQueryContext");
-    if (vtable.QueryContext == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglQueryContext: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.QueryString = dlsym(so_handle, "eglQueryString");
-    if (vtable.QueryString == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglQueryString: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.QuerySurface = dlsym(so_handle, "eglQuerySurface");
-    if (vtable.QuerySurface == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglQuerySurface: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.SwapBuffers = dlsym(so_handle, "eglSwapBuffers");
-    if (vtable.SwapBuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglSwapBuffers: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.Terminate = dlsym(so_handle, "eglTerminate");
-    if (vtable.Terminate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglTerminate: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.WaitGL = dlsym(so_handle, "eglWaitGL");
-    if (vtable.WaitGL == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglWaitGL: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-    vtable.WaitNative = dlsym(so_handle, "eglWaitNative");
-    if (vtable.WaitNative == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load eglWaitNative: %s",
-            dlerror()
-        );
-        exit(1);
-    }
-
-    return vtable;
-}
-
-typedef struct {
-    EGLDisplay display;
-    EGLConfig config;
-    EGLContext context;
-    EGLSurface surface;
-} SEglCtx;
-
-static SEglCtx segl_ctx_load(AndroidApp *app, SEglVtable *segl_vtable) {
-    SEglCtx segl_ctx;
-
-    segl_ctx.display = segl_vtable->GetDisplay(EGL_DEFAULT_DISPLAY);
-    if (segl_ctx.display == EGL_NO_DISPLAY) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to find EGL display"
-        );
-        exit(1);
-    }
-
-    EGLint major;
-    EGLint minor;
-    if (!segl_vtable->Initialize(segl_ctx.display, &major, &minor)) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to initialize EGL display"
-        );
-        exit(1);
-    }
-
-    // NOTE: may wish to require an 8 bit alpha channel as well
-    const EGLint attribs[] = {
-        EGL_SURFACE_TYPE,
-        EGL_WINDOW_BIT,
-        EGL_CONFORMANT,
-        EGL_OPENGL_ES2_BIT,
-        EGL_RENDERABLE_TYPE,
-        EGL_OPENGL_ES2_BIT,
-        EGL_COLOR_BUFFER_TYPE,
-        EGL_RGB_BUFFER,
-        EGL_RED_SIZE,
-        8,
-        EGL_GREEN_SIZE,
-        8,
-        EGL_BLUE_SIZE,
-        8,
-        EGL_NONE,
-    };
-    EGLConfig configs[32];
-    EGLint nconfigs;
-    if (
-        !segl_vtable->ChooseConfig(
-            segl_ctx.display,
-            attribs,
-            configs,
-            (EGLint)countof(configs),
-            &nconfigs
-        ) ||
-        nconfigs == 0
-    ) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to find EGL config"
-        );
-        exit(1);
-    }
-
-    // NOTE: we just select the config with the most MSAA samples from first 32
-    EGLint best_i = 0;
-    EGLint max_samples = 0;
-    for (EGLint i = 0; i < nconfigs; i += 1) {
-        EGLint samples;
-        segl_vtable->GetConfigAttrib(
-            segl_ctx.display,
-            configs[i],
-            EGL_SAMPLES,
-            &samples
-        );
-        if (samples > max_samples) {
-            best_i = i;
-            max_samples = samples;
-        }
-    }
-
-    segl_ctx.config = configs[best_i];
-    const EGLint context_attribs[] = {
-        EGL_CONTEXT_MAJOR_VERSION,
-        2,
-        EGL_CONTEXT_MINOR_VERSION,
-        0,
-        EGL_NONE,
-    };
-    segl_ctx.context = segl_vtable->CreateContext(
-        segl_ctx.display,
-        segl_ctx.config,
-        EGL_NO_CONTEXT,
-        context_attribs
-    );
-    if (segl_ctx.context == EGL_NO_CONTEXT) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to create EGL context"
-        );
-        exit(1);
-    }
-    segl_ctx.surface = segl_vtable->CreateWindowSurface(
-        segl_ctx.display,
-        segl_ctx.config,
-        app->window,
-        NULL
-    );
-    if (segl_ctx.surface == EGL_NO_SURFACE) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to create EGL surface"
-        );
-        exit(1);
-    }
-
-    if (
-        !segl_vtable->MakeCurrent(
-            segl_ctx.display,
-            segl_ctx.surface,
-            segl_ctx.surface,
-            segl_ctx.context
-        )
-    ) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to set EGL surface and context"
-        );
-        exit(1);
-    }
-
-    return segl_ctx;
-}
-
-static void segl_ctx_unload(SEglCtx *segl_ctx, SEglVtable *segl_vtable) {
-    if (segl_ctx->display == EGL_NO_DISPLAY) {
-        return;
-    }
-
-    segl_vtable->MakeCurrent(
-        segl_ctx->display,
-        EGL_NO_SURFACE,
-        EGL_NO_SURFACE,
-        EGL_NO_CONTEXT
-    );
-
-    if (segl_ctx->context != EGL_NO_CONTEXT) {
-        segl_vtable->DestroyContext(segl_ctx->display, segl_ctx->context);
-    }
-
-    if (segl_ctx->surface != EGL_NO_SURFACE) {
-        segl_vtable->DestroySurface(segl_ctx->display, segl_ctx->surface);
-    }
-
-    segl_vtable->Terminate(segl_ctx->display);
-
-    segl_ctx->display = EGL_NO_DISPLAY;
-    segl_ctx->context = EGL_NO_CONTEXT;
-    segl_ctx->surface = EGL_NO_SURFACE;
-}
-
-typedef struct {
-    PFNGLACTIVETEXTUREPROC ActiveTexture;
-    PFNGLATTACHSHADERPROC AttachShader;
-    PFNGLBINDATTRIBLOCATIONPROC BindAttribLocation;
-    PFNGLBINDBUFFERPROC BindBuffer;
-    PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
-    PFNGLBINDRENDERBUFFERPROC BindRenderbuffer;
-    PFNGLBINDTEXTUREPROC BindTexture;
-    PFNGLBLENDCOLORPROC BlendColor;
-    PFNGLBLENDEQUATIONPROC BlendEquation;
-    PFNGLBLENDEQUATIONSEPARATEPROC BlendEquationSeparate;
-    PFNGLBLENDFUNCPROC BlendFunc;
-    PFNGLBLENDFUNCSEPARATEPROC BlendFuncSeparate;
-    PFNGLBUFFERDATAPROC BufferData;
-    PFNGLBUFFERSUBDATAPROC BufferSubData;
-    PFNGLCHECKFRAMEBUFFERSTATUSPROC CheckFramebufferStatus;
-    PFNGLCLEARPROC Clear;
-    PFNGLCLEARCOLORPROC ClearColor;
-    PFNGLCLEARDEPTHFPROC ClearDepthf;
-    PFNGLCLEARSTENCILPROC ClearStencil;
-    PFNGLCOLORMASKPROC ColorMask;
-    PFNGLCOMPILESHADERPROC CompileShader;
-    PFNGLCOMPRESSEDTEXIMAGE2DPROC CompressedTexImage2D;
-    PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC CompressedTexSubImage2D;
-    PFNGLCOPYTEXIMAGE2DPROC CopyTexImage2D;
-    PFNGLCOPYTEXSUBIMAGE2DPROC CopyTexSubImage2D;
-    PFNGLCREATEPROGRAMPROC CreateProgram;
-    PFNGLCREATESHADERPROC CreateShader;
-    PFNGLCULLFACEPROC CullFace;
-    PFNGLDELETEBUFFERSPROC DeleteBuffers;
-    PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers;
-    PFNGLDELETEPROGRAMPROC DeleteProgram;
-    PFNGLDELETERENDERBUFFERSPROC DeleteRenderbuffers;
-    PFNGLDELETESHADERPROC DeleteShader;
-    PFNGLDELETETEXTURESPROC DeleteTextures;
-    PFNGLDEPTHFUNCPROC DepthFunc;
-    PFNGLDEPTHMASKPROC DepthMask;
-    PFNGLDEPTHRANGEFPROC DepthRangef;
-    PFNGLDETACHSHADERPROC DetachShader;
-    PFNGLDISABLEPROC Disable;
-    PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray;
-    PFNGLDRAWARRAYSPROC DrawArrays;
-    PFNGLDRAWELEMENTSPROC DrawElements;
-    PFNGLENABLEPROC Enable;
-    PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
-    PFNGLFINISHPROC Finish;
-    PFNGLFLUSHPROC Flush;
-    PFNGLFRAMEBUFFERRENDERBUFFERPROC FramebufferRenderbuffer;
-    PFNGLFRAMEBUFFERTEXTURE2DPROC FramebufferTexture2D;
-    PFNGLFRONTFACEPROC FrontFace;
-    PFNGLGENBUFFERSPROC GenBuffers;
-    PFNGLGENERATEMIPMAPPROC GenerateMipmap;
-    PFNGLGENFRAMEBUFFERSPROC GenFramebuffers;
-    PFNGLGENRENDERBUFFERSPROC GenRenderbuffers;
-    PFNGLGENTEXTURESPROC GenTextures;
-    PFNGLGETACTIVEATTRIBPROC GetActiveAttrib;
-    PFNGLGETACTIVEUNIFORMPROC GetActiveUniform;
-    PFNGLGETATTACHEDSHADERSPROC GetAttachedShaders;
-    PFNGLGETATTRIBLOCATIONPROC GetAttribLocation;
-    PFNGLGETBOOLEANVPROC GetBooleanv;
-    PFNGLGETBUFFERPARAMETERIVPROC GetBufferParameteriv;
-    PFNGLGETERRORPROC GetError;
-    PFNGLGETFLOATVPROC GetFloatv;
-    PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC
-        GetFramebufferAttachmentParameteriv;
-    PFNGLGETINTEGERVPROC GetIntegerv;
-    PFNGLGETPROGRAMIVPROC GetProgramiv;
-    PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog;
-    PFNGLGETRENDERBUFFERPARAMETERIVPROC GetRenderbufferParameteriv;
-    PFNGLGETSHADERIVPROC GetShaderiv;
-    PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog;
-    PFNGLGETSHADERPRECISIONFORMATPROC GetShaderPrecisionFormat;
-    PFNGLGETSHADERSOURCEPROC GetShaderSource;
-    PFNGLGETSTRINGPROC GetString;
-    PFNGLGETTEXPARAMETERFVPROC GetTexParameterfv;
-    PFNGLGETTEXPARAMETERIVPROC GetTexParameteriv;
-    PFNGLGETUNIFORMFVPROC GetUniformfv;
-    PFNGLGETUNIFORMIVPROC GetUniformiv;
-    PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
-    PFNGLGETVERTEXATTRIBFVPROC GetVertexAttribfv;
-    PFNGLGETVERTEXATTRIBIVPROC GetVertexAttribiv;
-    PFNGLGETVERTEXATTRIBPOINTERVPROC GetVertexAttribPointerv;
-    PFNGLHINTPROC Hint;
-    PFNGLISBUFFERPROC IsBuffer;
-    PFNGLISENABLEDPROC IsEnabled;
-    PFNGLISFRAMEBUFFERPROC IsFramebuffer;
-    PFNGLISPROGRAMPROC IsProgram;
-    PFNGLISRENDERBUFFERPROC IsRenderbuffer;
-    PFNGLISSHADERPROC IsShader;
-    PFNGLISTEXTUREPROC IsTexture;
-    PFNGLLINEWIDTHPROC LineWidth;
-    PFNGLLINKPROGRAMPROC LinkProgram;
-    PFNGLPIXELSTOREIPROC PixelStorei;
-    PFNGLPOLYGONOFFSETPROC PolygonOffset;
-    PFNGLREADPIXELSPROC ReadPixels;
-    PFNGLRELEASESHADERCOMPILERPROC ReleaseShaderCompiler;
-    PFNGLRENDERBUFFERSTORAGEPROC RenderbufferStorage;
-    PFNGLSAMPLECOVERAGEPROC SampleCoverage;
-    PFNGLSCISSORPROC Scissor;
-    PFNGLSHADERBINARYPROC ShaderBinary;
-    PFNGLSHADERSOURCEPROC ShaderSource;
-    PFNGLSTENCILFUNCPROC StencilFunc;
-    PFNGLSTENCILFUNCSEPARATEPROC StencilFuncSeparate;
-    PFNGLSTENCILMASKPROC StencilMask;
-    PFNGLSTENCILMASKSEPARATEPROC StencilMaskSeparate;
-    PFNGLSTENCILOPPROC StencilOp;
-    PFNGLSTENCILOPSEPARATEPROC StencilOpSeparate;
-    PFNGLTEXIMAGE2DPROC TexImage2D;
-    PFNGLTEXPARAMETERFPROC TexParameterf;
-    PFNGLTEXPARAMETERFVPROC TexParameterfv;
-    PFNGLTEXPARAMETERIPROC TexParameteri;
-    PFNGLTEXPARAMETERIVPROC TexParameteriv;
-    PFNGLTEXSUBIMAGE2DPROC TexSubImage2D;
-    PFNGLUNIFORM1FPROC Uniform1f;
-    PFNGLUNIFORM1FVPROC Uniform1fv;
-    PFNGLUNIFORM1IPROC Uniform1i;
-    PFNGLUNIFORM1IVPROC Uniform1iv;
-    PFNGLUNIFORM2FPROC Uniform2f;
-    PFNGLUNIFORM2FVPROC Uniform2fv;
-    PFNGLUNIFORM2IPROC Uniform2i;
-    PFNGLUNIFORM2IVPROC Uniform2iv;
-    PFNGLUNIFORM3FPROC Uniform3f;
-    PFNGLUNIFORM3FVPROC Uniform3fv;
-    PFNGLUNIFORM3IPROC Uniform3i;
-    PFNGLUNIFORM3IVPROC Uniform3iv;
-    PFNGLUNIFORM4FPROC Uniform4f;
-    PFNGLUNIFORM4FVPROC Uniform4fv;
-    PFNGLUNIFORM4IPROC Uniform4i;
-    PFNGLUNIFORM4IVPROC Uniform4iv;
-    PFNGLUNIFORMMATRIX2FVPROC UniformMatrix2fv;
-    PFNGLUNIFORMMATRIX3FVPROC UniformMatrix3fv;
-    PFNGLUNIFORMMATRIX4FVPROC UniformMatrix4fv;
-    PFNGLUSEPROGRAMPROC UseProgram;
-    PFNGLVALIDATEPROGRAMPROC ValidateProgram;
-    PFNGLVERTEXATTRIB1FPROC VertexAttrib1f;
-    PFNGLVERTEXATTRIB1FVPROC VertexAttrib1fv;
-    PFNGLVERTEXATTRIB2FPROC VertexAttrib2f;
-    PFNGLVERTEXATTRIB2FVPROC VertexAttrib2fv;
-    PFNGLVERTEXATTRIB3FPROC VertexAttrib3f;
-    PFNGLVERTEXATTRIB3FVPROC VertexAttrib3fv;
-    PFNGLVERTEXATTRIB4FPROC VertexAttrib4f;
-    PFNGLVERTEXATTRIB4FVPROC VertexAttrib4fv;
-    PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
-    PFNGLVIEWPORTPROC Viewport;
-} SGlVtable;
-
-static SGlVtable sgl_vtable_load(SEglVtable *segl_vtable) {
-    SGlVtable vtable = { 0 };
-
-    vtable.ActiveTexture = (PFNGLACTIVETEXTUREPROC)segl_vtable->GetProcAddress(
-        "glActiveTexture"
-    );
-    if (vtable.ActiveTexture == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glActiveTexture"
-        );
-        exit(1);
-    }
-    vtable.AttachShader = (PFNGLATTACHSHADERPROC)segl_vtable->GetProcAddress(
-        "glAttachShader"
-    );
-    if (vtable.AttachShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glAttachShader"
-        );
-        exit(1);
-    }
-    vtable.BindAttribLocation = (PFNGLBINDATTRIBLOCATIONPROC)segl_vtable
-        ->GetProcAddress("glBindAttribLocation");
-    if (vtable.BindAttribLocation == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBindAttribLocation"
-        );
-        exit(1);
-    }
-    vtable.BindBuffer = (PFNGLBINDBUFFERPROC)segl_vtable->GetProcAddress(
-        "glBindBuffer"
-    );
-    if (vtable.BindBuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBindBuffer"
-        );
-        exit(1);
-    }
-    vtable.BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)segl_vtable
-        ->GetProcAddress("glBindFramebuffer");
-    if (vtable.BindFramebuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBindFramebuffer"
-        );
-        exit(1);
-    }
-    vtable.BindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)segl_vtable
-        ->GetProcAddress("glBindRenderbuffer");
-    if (vtable.BindRenderbuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBindRenderbuffer"
-        );
-        exit(1);
-    }
-    vtable.BindTexture = (PFNGLBINDTEXTUREPROC)segl_vtable->GetProcAddress(
-        "glBindTexture"
-    );
-    if (vtable.BindTexture == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBindTexture"
-        );
-        exit(1);
-    }
-    vtable.BlendColor = (PFNGLBLENDCOLORPROC)segl_vtable->GetProcAddress(
-        "glBlendColor"
-    );
-    if (vtable.BlendColor == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBlendColor"
-        );
-        exit(1);
-    }
-    vtable.BlendEquation = (PFNGLBLENDEQUATIONPROC)segl_vtable->GetProcAddress(
-        "glBlendEquation"
-    );
-    if (vtable.BlendEquation == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBlendEquation"
-        );
-        exit(1);
-    }
-    vtable.BlendEquationSeparate = (PFNGLBLENDEQUATIONSEPARATEPROC)segl_vtable
-        ->GetProcAddress("glBlendEquationSeparate");
-    if (vtable.BlendEquationSeparate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBlendEquationSeparate"
-        );
-        exit(1);
-    }
-    vtable.BlendFunc = (PFNGLBLENDFUNCPROC)segl_vtable->GetProcAddress(
-        "glBlendFunc"
-    );
-    if (vtable.BlendFunc == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBlendFunc"
-        );
-        exit(1);
-    }
-    vtable.BlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)segl_vtable
-        ->GetProcAddress("glBlendFuncSeparate");
-    if (vtable.BlendFuncSeparate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBlendFuncSeparate"
-        );
-        exit(1);
-    }
-    vtable.BufferData = (PFNGLBUFFERDATAPROC)segl_vtable->GetProcAddress(
-        "glBufferData"
-    );
-    if (vtable.BufferData == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBufferData"
-        );
-        exit(1);
-    }
-    vtable.BufferSubData = (PFNGLBUFFERSUBDATAPROC)segl_vtable->GetProcAddress(
-        "glBufferSubData"
-    );
-    if (vtable.BufferSubData == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glBufferSubData"
-        );
-        exit(1);
-    }
-    vtable.CheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)segl_vtable
-        ->GetProcAddress("glCheckFramebufferStatus");
-    if (vtable.CheckFramebufferStatus == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCheckFramebufferStatus"
-        );
-        exit(1);
-    }
-    vtable.Clear = (PFNGLCLEARPROC)segl_vtable->GetProcAddress("glClear");
-    if (vtable.Clear == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glClear"
-        );
-        exit(1);
-    }
-    vtable.ClearColor = (PFNGLCLEARCOLORPROC)segl_vtable->GetProcAddress(
-        "glClearColor"
-    );
-    if (vtable.ClearColor == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glClearColor"
-        );
-        exit(1);
-    }
-    vtable.ClearDepthf = (PFNGLCLEARDEPTHFPROC)segl_vtable->GetProcAddress(
-        "glClearDepthf"
-    );
-    if (vtable.ClearDepthf == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glClearDepthf"
-        );
-        exit(1);
-    }
-    vtable.ClearStencil = (PFNGLCLEARSTENCILPROC)segl_vtable->GetProcAddress(
-        "glClearStencil"
-    );
-    if (vtable.ClearStencil == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glClearStencil"
-        );
-        exit(1);
-    }
-    vtable.ColorMask = (PFNGLCOLORMASKPROC)segl_vtable->GetProcAddress(
-        "glColorMask"
-    );
-    if (vtable.ColorMask == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glColorMask"
-        );
-        exit(1);
-    }
-    vtable.CompileShader = (PFNGLCOMPILESHADERPROC)segl_vtable->GetProcAddress(
-        "glCompileShader"
-    );
-    if (vtable.CompileShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCompileShader"
-        );
-        exit(1);
-    }
-    vtable.CompressedTexImage2D = (PFNGLCOMPRESSEDTEXIMAGE2DPROC)segl_vtable
-        ->GetProcAddress("glCompressedTexImage2D");
-    if (vtable.CompressedTexImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCompressedTexImage2D"
-        );
-        exit(1);
-    }
-    vtable.CompressedTexSubImage2D = (PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)
-        segl_vtable->GetProcAddress("glCompressedTexSubImage2D");
-    if (vtable.CompressedTexSubImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCompressedTexSubImage2D"
-        );
-        exit(1);
-    }
-    vtable.CopyTexImage2D = (PFNGLCOPYTEXIMAGE2DPROC)segl_vtable->GetProcAddress(
-        "glCopyTexImage2D"
-    );
-    if (vtable.CopyTexImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCopyTexImage2D"
-        );
-        exit(1);
-    }
-    vtable.CopyTexSubImage2D = (PFNGLCOPYTEXSUBIMAGE2DPROC)segl_vtable
-        ->GetProcAddress("glCopyTexSubImage2D");
-    if (vtable.CopyTexSubImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCopyTexSubImage2D"
-        );
-        exit(1);
-    }
-    vtable.CreateProgram = (PFNGLCREATEPROGRAMPROC)segl_vtable->GetProcAddress(
-        "glCreateProgram"
-    );
-    if (vtable.CreateProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCreateProgram"
-        );
-        exit(1);
-    }
-    vtable.CreateShader = (PFNGLCREATESHADERPROC)segl_vtable->GetProcAddress(
-        "glCreateShader"
-    );
-    if (vtable.CreateShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCreateShader"
-        );
-        exit(1);
-    }
-    vtable.CullFace = (PFNGLCULLFACEPROC)segl_vtable->GetProcAddress(
-        "glCullFace"
-    );
-    if (vtable.CullFace == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glCullFace"
-        );
-        exit(1);
-    }
-    vtable.DeleteBuffers = (PFNGLDELETEBUFFERSPROC)segl_vtable->GetProcAddress(
-        "glDeleteBuffers"
-    );
-    if (vtable.DeleteBuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteBuffers"
-        );
-        exit(1);
-    }
-    vtable.DeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)segl_vtable
-        ->GetProcAddress("glDeleteFramebuffers");
-    if (vtable.DeleteFramebuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteFramebuffers"
-        );
-        exit(1);
-    }
-    vtable.DeleteProgram = (PFNGLDELETEPROGRAMPROC)segl_vtable->GetProcAddress(
-        "glDeleteProgram"
-    );
-    if (vtable.DeleteProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteProgram"
-        );
-        exit(1);
-    }
-    vtable.DeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)segl_vtable
-        ->GetProcAddress("glDeleteRenderbuffers");
-    if (vtable.DeleteRenderbuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteRenderbuffers"
-        );
-        exit(1);
-    }
-    vtable.DeleteShader = (PFNGLDELETESHADERPROC)segl_vtable->GetProcAddress(
-        "glDeleteShader"
-    );
-    if (vtable.DeleteShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteShader"
-        );
-        exit(1);
-    }
-    vtable.DeleteTextures = (PFNGLDELETETEXTURESPROC)segl_vtable->GetProcAddress(
-        "glDeleteTextures"
-    );
-    if (vtable.DeleteTextures == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDeleteTextures"
-        );
-        exit(1);
-    }
-    vtable.DepthFunc = (PFNGLDEPTHFUNCPROC)segl_vtable->GetProcAddress(
-        "glDepthFunc"
-    );
-    if (vtable.DepthFunc == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDepthFunc"
-        );
-        exit(1);
-    }
-    vtable.DepthMask = (PFNGLDEPTHMASKPROC)segl_vtable->GetProcAddress(
-        "glDepthMask"
-    );
-    if (vtable.DepthMask == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDepthMask"
-        );
-        exit(1);
-    }
-    vtable.DepthRangef = (PFNGLDEPTHRANGEFPROC)segl_vtable->GetProcAddress(
-        "glDepthRangef"
-    );
-    if (vtable.DepthRangef == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDepthRangef"
-        );
-        exit(1);
-    }
-    vtable.DetachShader = (PFNGLDETACHSHADERPROC)segl_vtable->GetProcAddress(
-        "glDetachShader"
-    );
-    if (vtable.DetachShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDetachShader"
-        );
-        exit(1);
-    }
-    vtable.Disable = (PFNGLDISABLEPROC)segl_vtable->GetProcAddress("glDisable");
-    if (vtable.Disable == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDisable"
-        );
-        exit(1);
-    }
-    vtable.DisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)
-        segl_vtable->GetProcAddress("glDisableVertexAttribArray");
-    if (vtable.DisableVertexAttribArray == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDisableVertexAttribArray"
-        );
-        exit(1);
-    }
-    vtable.DrawArrays = (PFNGLDRAWARRAYSPROC)segl_vtable->GetProcAddress(
-        "glDrawArrays"
-    );
-    if (vtable.DrawArrays == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDrawArrays"
-        );
-        exit(1);
-    }
-    vtable.DrawElements = (PFNGLDRAWELEMENTSPROC)segl_vtable->GetProcAddress(
-        "glDrawElements"
-    );
-    if (vtable.DrawElements == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glDrawElements"
-        );
-        exit(1);
-    }
-    vtable.Enable = (PFNGLENABLEPROC)segl_vtable->GetProcAddress("glEnable");
-    if (vtable.Enable == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glEnable"
-        );
-        exit(1);
-    }
-    vtable.EnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)
-        segl_vtable->GetProcAddress("glEnableVertexAttribArray");
-    if (vtable.EnableVertexAttribArray == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glEnableVertexAttribArray"
-        );
-        exit(1);
-    }
-    vtable.Finish = (PFNGLFINISHPROC)segl_vtable->GetProcAddress("glFinish");
-    if (vtable.Finish == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glFinish"
-        );
-        exit(1);
-    }
-    vtable.Flush = (PFNGLFLUSHPROC)segl_vtable->GetProcAddress("glFlush");
-    if (vtable.Flush == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glFlush"
-        );
-        exit(1);
-    }
-    vtable.FramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)
-        segl_vtable->GetProcAddress("glFramebufferRenderbuffer");
-    if (vtable.FramebufferRenderbuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glFramebufferRenderbuffer"
-        );
-        exit(1);
-    }
-    vtable.FramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)segl_vtable
-        ->GetProcAddress("glFramebufferTexture2D");
-    if (vtable.FramebufferTexture2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glFramebufferTexture2D"
-        );
-        exit(1);
-    }
-    vtable.FrontFace = (PFNGLFRONTFACEPROC)segl_vtable->GetProcAddress(
-        "glFrontFace"
-    );
-    if (vtable.FrontFace == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glFrontFace"
-        );
-        exit(1);
-    }
-    vtable.GenBuffers = (PFNGLGENBUFFERSPROC)segl_vtable->GetProcAddress(
-        "glGenBuffers"
-    );
-    if (vtable.GenBuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGenBuffers"
-        );
-        exit(1);
-    }
-    vtable.GenerateMipmap = (PFNGLGENERATEMIPMAPPROC)segl_vtable->GetProcAddress(
-        "glGenerateMipmap"
-    );
-    if (vtable.GenerateMipmap == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGenerateMipmap"
-        );
-        exit(1);
-    }
-    vtable.GenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)segl_vtable
-        ->GetProcAddress("glGenFramebuffers");
-    if (vtable.GenFramebuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGenFramebuffers"
-        );
-        exit(1);
-    }
-    vtable.GenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)segl_vtable
-        ->GetProcAddress("glGenRenderbuffers");
-    if (vtable.GenRenderbuffers == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGenRenderbuffers"
-        );
-        exit(1);
-    }
-    vtable.GenTextures = (PFNGLGENTEXTURESPROC)segl_vtable->GetProcAddress(
-        "glGenTextures"
-    );
-    if (vtable.GenTextures == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGenTextures"
-        );
-        exit(1);
-    }
-    vtable.GetActiveAttrib = (PFNGLGETACTIVEATTRIBPROC)segl_vtable
-        ->GetProcAddress("glGetActiveAttrib");
-    if (vtable.GetActiveAttrib == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetActiveAttrib"
-        );
-        exit(1);
-    }
-    vtable.GetActiveUniform = (PFNGLGETACTIVEUNIFORMPROC)segl_vtable
-        ->GetProcAddress("glGetActiveUniform");
-    if (vtable.GetActiveUniform == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetActiveUniform"
-        );
-        exit(1);
-    }
-    vtable.GetAttachedShaders = (PFNGLGETATTACHEDSHADERSPROC)segl_vtable
-        ->GetProcAddress("glGetAttachedShaders");
-    if (vtable.GetAttachedShaders == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetAttachedShaders"
-        );
-        exit(1);
-    }
-    vtable.GetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)segl_vtable
-        ->GetProcAddress("glGetAttribLocation");
-    if (vtable.GetAttribLocation == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetAttribLocation"
-        );
-        exit(1);
-    }
-    vtable.GetBooleanv = (PFNGLGETBOOLEANVPROC)segl_vtable->GetProcAddress(
-        "glGetBooleanv"
-    );
-    if (vtable.GetBooleanv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetBooleanv"
-        );
-        exit(1);
-    }
-    vtable.GetBufferParameteriv = (PFNGLGETBUFFERPARAMETERIVPROC)segl_vtable
-        ->GetProcAddress("glGetBufferParameteriv");
-    if (vtable.GetBufferParameteriv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetBufferParameteriv"
-        );
-        exit(1);
-    }
-    vtable.GetError = (PFNGLGETERRORPROC)segl_vtable->GetProcAddress(
-        "glGetError"
-    );
-    if (vtable.GetError == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetError"
-        );
-        exit(1);
-    }
-    vtable.GetFloatv = (PFNGLGETFLOATVPROC)segl_vtable->GetProcAddress(
-        "glGetFloatv"
-    );
-    if (vtable.GetFloatv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetFloatv"
-        );
-        exit(1);
-    }
-    vtable.GetFramebufferAttachmentParameteriv = (
-        PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC
-    )segl_vtable->GetProcAddress("glGetFramebufferAttachmentParameteriv");
-    if (vtable.GetFramebufferAttachmentParameteriv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetFramebufferAttachmentParameteriv"
-        );
-        exit(1);
-    }
-    vtable.GetIntegerv = (PFNGLGETINTEGERVPROC)segl_vtable->GetProcAddress(
-        "glGetIntegerv"
-    );
-    if (vtable.GetIntegerv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetIntegerv"
-        );
-        exit(1);
-    }
-    vtable.GetProgramiv = (PFNGLGETPROGRAMIVPROC)segl_vtable->GetProcAddress(
-        "glGetProgramiv"
-    );
-    if (vtable.GetProgramiv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetProgramiv"
-        );
-        exit(1);
-    }
-    vtable.GetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)segl_vtable
-        ->GetProcAddress("glGetProgramInfoLog");
-    if (vtable.GetProgramInfoLog == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetProgramInfoLog"
-        );
-        exit(1);
-    }
-    vtable.GetRenderbufferParameteriv = (PFNGLGETRENDERBUFFERPARAMETERIVPROC)
-        segl_vtable->GetProcAddress("glGetRenderbufferParameteriv");
-    if (vtable.GetRenderbufferParameteriv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetRenderbufferParameteriv"
-        );
-        exit(1);
-    }
-    vtable.GetShaderiv = (PFNGLGETSHADERIVPROC)segl_vtable->GetProcAddress(
-        "glGetShaderiv"
-    );
-    if (vtable.GetShaderiv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetShaderiv"
-        );
-        exit(1);
-    }
-    vtable.GetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)segl_vtable
-        ->GetProcAddress("glGetShaderInfoLog");
-    if (vtable.GetShaderInfoLog == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetShaderInfoLog"
-        );
-        exit(1);
-    }
-    vtable.GetShaderPrecisionFormat = (PFNGLGETSHADERPRECISIONFORMATPROC)
-        segl_vtable->GetProcAddress("glGetShaderPrecisionFormat");
-    if (vtable.GetShaderPrecisionFormat == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetShaderPrecisionFormat"
-        );
-        exit(1);
-    }
-    vtable.GetShaderSource = (PFNGLGETSHADERSOURCEPROC)segl_vtable
-        ->GetProcAddress("glGetShaderSource");
-    if (vtable.GetShaderSource == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetShaderSource"
-        );
-        exit(1);
-    }
-    vtable.GetString = (PFNGLGETSTRINGPROC)segl_vtable->GetProcAddress(
-        "glGetString"
-    );
-    if (vtable.GetString == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetString"
-        );
-        exit(1);
-    }
-    vtable.GetTexParameterfv = (PFNGLGETTEXPARAMETERFVPROC)segl_vtable
-        ->GetProcAddress("glGetTexParameterfv");
-    if (vtable.GetTexParameterfv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetTexParameterfv"
-        );
-        exit(1);
-    }
-    vtable.GetTexParameteriv = (PFNGLGETTEXPARAMETERIVPROC)segl_vtable
-        ->GetProcAddress("glGetTexParameteriv");
-    if (vtable.GetTexParameteriv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetTexParameteriv"
-        );
-        exit(1);
-    }
-    vtable.GetUniformfv = (PFNGLGETUNIFORMFVPROC)segl_vtable->GetProcAddress(
-        "glGetUniformfv"
-    );
-    if (vtable.GetUniformfv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetUniformfv"
-        );
-        exit(1);
-    }
-    vtable.GetUniformiv = (PFNGLGETUNIFORMIVPROC)segl_vtable->GetProcAddress(
-        "glGetUniformiv"
-    );
-    if (vtable.GetUniformiv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetUniformiv"
-        );
-        exit(1);
-    }
-    vtable.GetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)segl_vtable
-        ->GetProcAddress("glGetUniformLocation");
-    if (vtable.GetUniformLocation == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetUniformLocation"
-        );
-        exit(1);
-    }
-    vtable.GetVertexAttribfv = (PFNGLGETVERTEXATTRIBFVPROC)segl_vtable
-        ->GetProcAddress("glGetVertexAttribfv");
-    if (vtable.GetVertexAttribfv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetVertexAttribfv"
-        );
-        exit(1);
-    }
-    vtable.GetVertexAttribiv = (PFNGLGETVERTEXATTRIBIVPROC)segl_vtable
-        ->GetProcAddress("glGetVertexAttribiv");
-    if (vtable.GetVertexAttribiv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetVertexAttribiv"
-        );
-        exit(1);
-    }
-    vtable.GetVertexAttribPointerv = (PFNGLGETVERTEXATTRIBPOINTERVPROC)
-        segl_vtable->GetProcAddress("glGetVertexAttribPointerv");
-    if (vtable.GetVertexAttribPointerv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glGetVertexAttribPointerv"
-        );
-        exit(1);
-    }
-    vtable.Hint = (PFNGLHINTPROC)segl_vtable->GetProcAddress("glHint");
-    if (vtable.Hint == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glHint"
-        );
-        exit(1);
-    }
-    vtable.IsBuffer = (PFNGLISBUFFERPROC)segl_vtable->GetProcAddress(
-        "glIsBuffer"
-    );
-    if (vtable.IsBuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsBuffer"
-        );
-        exit(1);
-    }
-    vtable.IsEnabled = (PFNGLISENABLEDPROC)segl_vtable->GetProcAddress(
-        "glIsEnabled"
-    );
-    if (vtable.IsEnabled == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsEnabled"
-        );
-        exit(1);
-    }
-    vtable.IsFramebuffer = (PFNGLISFRAMEBUFFERPROC)segl_vtable->GetProcAddress(
-        "glIsFramebuffer"
-    );
-    if (vtable.IsFramebuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsFramebuffer"
-        );
-        exit(1);
-    }
-    vtable.IsProgram = (PFNGLISPROGRAMPROC)segl_vtable->GetProcAddress(
-        "glIsProgram"
-    );
-    if (vtable.IsProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsProgram"
-        );
-        exit(1);
-    }
-    vtable.IsRenderbuffer = (PFNGLISRENDERBUFFERPROC)segl_vtable->GetProcAddress(
-        "glIsRenderbuffer"
-    );
-    if (vtable.IsRenderbuffer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsRenderbuffer"
-        );
-        exit(1);
-    }
-    vtable.IsShader = (PFNGLISSHADERPROC)segl_vtable->GetProcAddress(
-        "glIsShader"
-    );
-    if (vtable.IsShader == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsShader"
-        );
-        exit(1);
-    }
-    vtable.IsTexture = (PFNGLISTEXTUREPROC)segl_vtable->GetProcAddress(
-        "glIsTexture"
-    );
-    if (vtable.IsTexture == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glIsTexture"
-        );
-        exit(1);
-    }
-    vtable.LineWidth = (PFNGLLINEWIDTHPROC)segl_vtable->GetProcAddress(
-        "glLineWidth"
-    );
-    if (vtable.LineWidth == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glLineWidth"
-        );
-        exit(1);
-    }
-    vtable.LinkProgram = (PFNGLLINKPROGRAMPROC)segl_vtable->GetProcAddress(
-        "glLinkProgram"
-    );
-    if (vtable.LinkProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glLinkProgram"
-        );
-        exit(1);
-    }
-    vtable.PixelStorei = (PFNGLPIXELSTOREIPROC)segl_vtable->GetProcAddress(
-        "glPixelStorei"
-    );
-    if (vtable.PixelStorei == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glPixelStorei"
-        );
-        exit(1);
-    }
-    vtable.PolygonOffset = (PFNGLPOLYGONOFFSETPROC)segl_vtable->GetProcAddress(
-        "glPolygonOffset"
-    );
-    if (vtable.PolygonOffset == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glPolygonOffset"
-        );
-        exit(1);
-    }
-    vtable.ReadPixels = (PFNGLREADPIXELSPROC)segl_vtable->GetProcAddress(
-        "glReadPixels"
-    );
-    if (vtable.ReadPixels == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glReadPixels"
-        );
-        exit(1);
-    }
-    vtable.ReleaseShaderCompiler = (PFNGLRELEASESHADERCOMPILERPROC)segl_vtable
-        ->GetProcAddress("glReleaseShaderCompiler");
-    if (vtable.ReleaseShaderCompiler == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glReleaseShaderCompiler"
-        );
-        exit(1);
-    }
-    vtable.RenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)segl_vtable
-        ->GetProcAddress("glRenderbufferStorage");
-    if (vtable.RenderbufferStorage == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glRenderbufferStorage"
-        );
-        exit(1);
-    }
-    vtable.SampleCoverage = (PFNGLSAMPLECOVERAGEPROC)segl_vtable->GetProcAddress(
-        "glSampleCoverage"
-    );
-    if (vtable.SampleCoverage == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glSampleCoverage"
-        );
-        exit(1);
-    }
-    vtable.Scissor = (PFNGLSCISSORPROC)segl_vtable->GetProcAddress("glScissor");
-    if (vtable.Scissor == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glScissor"
-        );
-        exit(1);
-    }
-    vtable.ShaderBinary = (PFNGLSHADERBINARYPROC)segl_vtable->GetProcAddress(
-        "glShaderBinary"
-    );
-    if (vtable.ShaderBinary == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glShaderBinary"
-        );
-        exit(1);
-    }
-    vtable.ShaderSource = (PFNGLSHADERSOURCEPROC)segl_vtable->GetProcAddress(
-        "glShaderSource"
-    );
-    if (vtable.ShaderSource == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glShaderSource"
-        );
-        exit(1);
-    }
-    vtable.StencilFunc = (PFNGLSTENCILFUNCPROC)segl_vtable->GetProcAddress(
-        "glStencilFunc"
-    );
-    if (vtable.StencilFunc == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilFunc"
-        );
-        exit(1);
-    }
-    vtable.StencilFuncSeparate = (PFNGLSTENCILFUNCSEPARATEPROC)segl_vtable
-        ->GetProcAddress("glStencilFuncSeparate");
-    if (vtable.StencilFuncSeparate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilFuncSeparate"
-        );
-        exit(1);
-    }
-    vtable.StencilMask = (PFNGLSTENCILMASKPROC)segl_vtable->GetProcAddress(
-        "glStencilMask"
-    );
-    if (vtable.StencilMask == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilMask"
-        );
-        exit(1);
-    }
-    vtable.StencilMaskSeparate = (PFNGLSTENCILMASKSEPARATEPROC)segl_vtable
-        ->GetProcAddress("glStencilMaskSeparate");
-    if (vtable.StencilMaskSeparate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilMaskSeparate"
-        );
-        exit(1);
-    }
-    vtable.StencilOp = (PFNGLSTENCILOPPROC)segl_vtable->GetProcAddress(
-        "glStencilOp"
-    );
-    if (vtable.StencilOp == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilOp"
-        );
-        exit(1);
-    }
-    vtable.StencilOpSeparate = (PFNGLSTENCILOPSEPARATEPROC)segl_vtable
-        ->GetProcAddress("glStencilOpSeparate");
-    if (vtable.StencilOpSeparate == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glStencilOpSeparate"
-        );
-        exit(1);
-    }
-    vtable.TexImage2D = (PFNGLTEXIMAGE2DPROC)segl_vtable->GetProcAddress(
-        "glTexImage2D"
-    );
-    if (vtable.TexImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexImage2D"
-        );
-        exit(1);
-    }
-    vtable.TexParameterf = (PFNGLTEXPARAMETERFPROC)segl_vtable->GetProcAddress(
-        "glTexParameterf"
-    );
-    if (vtable.TexParameterf == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexParameterf"
-        );
-        exit(1);
-    }
-    vtable.TexParameterfv = (PFNGLTEXPARAMETERFVPROC)segl_vtable->GetProcAddress(
-        "glTexParameterfv"
-    );
-    if (vtable.TexParameterfv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexParameterfv"
-        );
-        exit(1);
-    }
-    vtable.TexParameteri = (PFNGLTEXPARAMETERIPROC)segl_vtable->GetProcAddress(
-        "glTexParameteri"
-    );
-    if (vtable.TexParameteri == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexParameteri"
-        );
-        exit(1);
-    }
-    vtable.TexParameteriv = (PFNGLTEXPARAMETERIVPROC)segl_vtable->GetProcAddress(
-        "glTexParameteriv"
-    );
-    if (vtable.TexParameteriv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexParameteriv"
-        );
-        exit(1);
-    }
-    vtable.TexSubImage2D = (PFNGLTEXSUBIMAGE2DPROC)segl_vtable->GetProcAddress(
-        "glTexSubImage2D"
-    );
-    if (vtable.TexSubImage2D == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glTexSubImage2D"
-        );
-        exit(1);
-    }
-    vtable.Uniform1f = (PFNGLUNIFORM1FPROC)segl_vtable->GetProcAddress(
-        "glUniform1f"
-    );
-    if (vtable.Uniform1f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform1f"
-        );
-        exit(1);
-    }
-    vtable.Uniform1fv = (PFNGLUNIFORM1FVPROC)segl_vtable->GetProcAddress(
-        "glUniform1fv"
-    );
-    if (vtable.Uniform1fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform1fv"
-        );
-        exit(1);
-    }
-    vtable.Uniform1i = (PFNGLUNIFORM1IPROC)segl_vtable->GetProcAddress(
-        "glUniform1i"
-    );
-    if (vtable.Uniform1i == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform1i"
-        );
-        exit(1);
-    }
-    vtable.Uniform1iv = (PFNGLUNIFORM1IVPROC)segl_vtable->GetProcAddress(
-        "glUniform1iv"
-    );
-    if (vtable.Uniform1iv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform1iv"
-        );
-        exit(1);
-    }
-    vtable.Uniform2f = (PFNGLUNIFORM2FPROC)segl_vtable->GetProcAddress(
-        "glUniform2f"
-    );
-    if (vtable.Uniform2f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform2f"
-        );
-        exit(1);
-    }
-    vtable.Uniform2fv = (PFNGLUNIFORM2FVPROC)segl_vtable->GetProcAddress(
-        "glUniform2fv"
-    );
-    if (vtable.Uniform2fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform2fv"
-        );
-        exit(1);
-    }
-    vtable.Uniform2i = (PFNGLUNIFORM2IPROC)segl_vtable->GetProcAddress(
-        "glUniform2i"
-    );
-    if (vtable.Uniform2i == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform2i"
-        );
-        exit(1);
-    }
-    vtable.Uniform2iv = (PFNGLUNIFORM2IVPROC)segl_vtable->GetProcAddress(
-        "glUniform2iv"
-    );
-    if (vtable.Uniform2iv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform2iv"
-        );
-        exit(1);
-    }
-    vtable.Uniform3f = (PFNGLUNIFORM3FPROC)segl_vtable->GetProcAddress(
-        "glUniform3f"
-    );
-    if (vtable.Uniform3f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform3f"
-        );
-        exit(1);
-    }
-    vtable.Uniform3fv = (PFNGLUNIFORM3FVPROC)segl_vtable->GetProcAddress(
-        "glUniform3fv"
-    );
-    if (vtable.Uniform3fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform3fv"
-        );
-        exit(1);
-    }
-    vtable.Uniform3i = (PFNGLUNIFORM3IPROC)segl_vtable->GetProcAddress(
-        "glUniform3i"
-    );
-    if (vtable.Uniform3i == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform3i"
-        );
-        exit(1);
-    }
-    vtable.Uniform3iv = (PFNGLUNIFORM3IVPROC)segl_vtable->GetProcAddress(
-        "glUniform3iv"
-    );
-    if (vtable.Uniform3iv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform3iv"
-        );
-        exit(1);
-    }
-    vtable.Uniform4f = (PFNGLUNIFORM4FPROC)segl_vtable->GetProcAddress(
-        "glUniform4f"
-    );
-    if (vtable.Uniform4f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform4f"
-        );
-        exit(1);
-    }
-    vtable.Uniform4fv = (PFNGLUNIFORM4FVPROC)segl_vtable->GetProcAddress(
-        "glUniform4fv"
-    );
-    if (vtable.Uniform4fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform4fv"
-        );
-        exit(1);
-    }
-    vtable.Uniform4i = (PFNGLUNIFORM4IPROC)segl_vtable->GetProcAddress(
-        "glUniform4i"
-    );
-    if (vtable.Uniform4i == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform4i"
-        );
-        exit(1);
-    }
-    vtable.Uniform4iv = (PFNGLUNIFORM4IVPROC)segl_vtable->GetProcAddress(
-        "glUniform4iv"
-    );
-    if (vtable.Uniform4iv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniform4iv"
-        );
-        exit(1);
-    }
-    vtable.UniformMatrix2fv = (PFNGLUNIFORMMATRIX2FVPROC)segl_vtable
-        ->GetProcAddress("glUniformMatrix2fv");
-    if (vtable.UniformMatrix2fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniformMatrix2fv"
-        );
-        exit(1);
-    }
-    vtable.UniformMatrix3fv = (PFNGLUNIFORMMATRIX3FVPROC)segl_vtable
-        ->GetProcAddress("glUniformMatrix3fv");
-    if (vtable.UniformMatrix3fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniformMatrix3fv"
-        );
-        exit(1);
-    }
-    vtable.UniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)segl_vtable
-        ->GetProcAddress("glUniformMatrix4fv");
-    if (vtable.UniformMatrix4fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUniformMatrix4fv"
-        );
-        exit(1);
-    }
-    vtable.UseProgram = (PFNGLUSEPROGRAMPROC)segl_vtable->GetProcAddress(
-        "glUseProgram"
-    );
-    if (vtable.UseProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glUseProgram"
-        );
-        exit(1);
-    }
-    vtable.ValidateProgram = (PFNGLVALIDATEPROGRAMPROC)segl_vtable
-        ->GetProcAddress("glValidateProgram");
-    if (vtable.ValidateProgram == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glValidateProgram"
-        );
-        exit(1);
-    }
-    vtable.VertexAttrib1f = (PFNGLVERTEXATTRIB1FPROC)segl_vtable->GetProcAddress(
-        "glVertexAttrib1f"
-    );
-    if (vtable.VertexAttrib1f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib1f"
-        );
-        exit(1);
-    }
-    vtable.VertexAttrib1fv = (PFNGLVERTEXATTRIB1FVPROC)segl_vtable
-        ->GetProcAddress("glVertexAttrib1fv");
-    if (vtable.VertexAttrib1fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib1fv"
-        );
-        exit(1);
-    }
-    vtable.VertexAttrib2f = (PFNGLVERTEXATTRIB2FPROC)segl_vtable->GetProcAddress(
-        "glVertexAttrib2f"
-    );
-    if (vtable.VertexAttrib2f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib2f"
-        );
-        exit(1);
+#include <android/native_window.h>
+
+#include "android_native_app_glue.h"
+#include "choreographer.h"
+#include "fixed_step.h"
+#include "frame_pacer.h"
+#include "frame_stats.h"
+#include "hud.h"
+#include "scene.h"
+#include "segl.h"
+#include "segl_damage.h"
+#include "segl_log.h"
+#include "segl_scale.h"
+#include "segl_surface.h"
+#include "segl_timing.h"
+#include "segl_trace.h"
+#include "segl_upload.h"
+
+#define TIMESTEP 16L * 1000L * 1000L
+// simulation steps per frame run one by one, the scene fast-forwards the
+// rest of a stall or a stay in the background
+#define MAX_STEPS_PER_FRAME 5
+// finished uploads handed to the render thread per frame
+#define UPLOAD_HANDOVERS_PER_FRAME 4
+// frames between display latency reports
+#define TIMING_REPORT_FRAMES 600
+// nominal display refresh, refined from the vsync timestamps
+#define REFRESH_NS 16666667L
+// wait between attempts to rebuild a lost surface or context
+#define RECOVERY_RETRY_MS 100
+
+// NOTE: frames start on every SEGL_FRAME_DIVISOR-th vsync, so 1, 2 or 3
+// give 60, 30 or 20 fps on a 60 Hz panel
+#ifndef SEGL_FRAME_DIVISOR
+#define SEGL_FRAME_DIVISOR 1
+#endif
+
+// frames swapped further apart than this dump the trace, at most once per
+// TRACE_HITCH_INTERVAL_NS
+#define TRACE_HITCH_NS (REFRESH_NS * SEGL_FRAME_DIVISOR * 3)
+#define TRACE_HITCH_INTERVAL_NS (10L * 1000L * 1000L * 1000L)
+
+// three fingers down and up again within this toggle the HUD
+#define HUD_TAP_NS (300L * 1000L * 1000L)
+
+// GPU time per frame the render scale aims to stay under, and its bounds
+#define SCALE_TARGET_NS (REFRESH_NS * SEGL_FRAME_DIVISOR)
+#define SCALE_MIN 0.5f
+#define SCALE_MAX 1.0f
+
+// NOTE: unthrottled runs measure the GL path without display pacing and
+// log frames per second and render thread CPU time per frame
+#ifdef SEGL_UNTHROTTLED
+#define SWAP_MODE SEGL_SWAP_UNTHROTTLED
+#elif defined(SEGL_ADAPTIVE_SWAP)
+#define SWAP_MODE SEGL_SWAP_ADAPTIVE
+#else
+#define SWAP_MODE SEGL_SWAP_VSYNC
+#endif
+
+typedef struct android_app AndroidApp;
+typedef struct android_poll_source AndroidPollSource;
+
+#ifdef SEGL_DIRECT_LINK
+
+// Direct-link mode: the vtables are compile time constants holding the
+// libEGL/libGLESv2 exports, so every egl.X and gl.X call folds into a direct
+// call that the compiler is free to inline.
+static const SEglVtable egl = { SEGL_EGL_PROCS(SEGL_DIRECT_X) };
+static const SGlVtable gl = { SGL_GL_PROCS(SGL_DIRECT_XR, SGL_DIRECT_XV) };
+
+#else // SEGL_DIRECT_LINK
+
+static SEglVtable egl;
+static SGlVtable gl;
+
+#endif // SEGL_DIRECT_LINK
+
+static SEglCtx egl_ctx;
+
+// NOTE: we only clear a full-screen surface, so MSAA and depth/stencil
+// buffers would only cost fill rate; the upload context needs a pbuffer
+static SEglConfigSpec egl_config_spec = {
+    .policy = SEGL_CONFIG_PERFORMANCE,
+    .surface_type = EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+};
+static SEglExt ext;
+
+// Config and caps of the previous run, in the app's internal data path.
+static SEglCache egl_cache;
+static char egl_cache_path[4096];
+
+static SEglSurfaceState surface;
+static SEglUploader uploader;
+static SEglDamage damage;
+static SEglTiming timing;
+// timing.head at the last latency report
+static uint64_t timing_reported;
+
+// Render scale of the window buffers; the compositor upscales them.
+static SEglScale scale;
+// frames swapped before the last scale change were rendered at the old one
+static int64_t scale_changed_ns;
+// buffer geometry last set on the window, 0x0 for the window's own size
+static int32_t geometry_width;
+static int32_t geometry_height;
+
+// Context and surface loss rebuilds through these instead of exiting.
+static SEglRecovery recovery;
+
+// Vsyncs come from AChoreographer, or from a timerfd on the looper where
+// it is missing; frames wait for one unless the swap mode is unthrottled.
+static FramePacer pacer;
+static bool paced;
+static Choreographer choreographer;
+static bool choreographer_loaded;
+static FrameTimer frame_timer;
+static bool frame_timer_armed;
+static bool frame_ready;
+
+#ifdef SEGL_FRAME_STATS
+static FrameStats frame_stats;
+#endif
+
+// Performance overlay, and the most fingers down in the current gesture.
+static Hud hud;
+static size_t hud_tap_pointers;
+
+#ifdef SEGL_TRACE
+// The trace goes to the app's files directory on APP_CMD_PAUSE, and to a
+// file of its own after a hitch.
+static char trace_path[4096];
+static char trace_hitch_path[4096];
+static int64_t trace_swap_ns;
+static int64_t trace_hitch_ns;
+#endif
+
+// Time from APP_CMD_INIT_WINDOW to the first swap on the new surface.
+static TimeSpec resume_start;
+static bool resume_pending;
+
+static void recovery_lost(SEglLoss loss, void *userdata) {
+    // NOTE: the upload context shares objects with the lost one, so it
+    // goes down with it
+    if (loss == SEGL_LOSS_CONTEXT) {
+        segl_upload_stop(&uploader);
+        hud_context_lost(&hud);
     }
-    vtable.VertexAttrib2fv = (PFNGLVERTEXATTRIB2FVPROC)segl_vtable
-        ->GetProcAddress("glVertexAttrib2fv");
-    if (vtable.VertexAttrib2fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib2fv"
-        );
-        exit(1);
+}
+
+static void recovery_restore(SEglLoss loss, void *userdata) {
+    if (loss == SEGL_LOSS_CONTEXT) {
+        segl_upload_start(&uploader, &egl_ctx, &egl, &gl, &ext);
+        // NOTE: the viewport went with the old context
+        segl_surface_reset(&surface);
     }
-    vtable.VertexAttrib3f = (PFNGLVERTEXATTRIB3FPROC)segl_vtable->GetProcAddress(
-        "glVertexAttrib3f"
-    );
-    if (vtable.VertexAttrib3f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib3f"
-        );
-        exit(1);
+    segl_surface_invalidate(&surface);
+    segl_surface_update(&surface, &egl_ctx, &egl);
+    segl_timing_start(&timing, &egl_ctx, &egl, &ext);
+}
+
+static void surface_resized(const SEglSurfaceState *state, void *userdata) {
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "surface %dx%d, content %dx%d at %d,%d",
+        state->width,
+        state->height,
+        state->content.width,
+        state->content.height,
+        state->content.x,
+        state->content.y
+    );
+    gl.Viewport(0, 0, state->width, state->height);
+    segl_damage_resize(&damage, state->width, state->height);
+}
+
+// Sets the buffer size unless it is already set; the buffers are
+// reallocated at the next dequeue.
+static void geometry_apply(AndroidApp *app, int32_t width, int32_t height) {
+    if (width == geometry_width && height == geometry_height) {
+        return;
     }
-    vtable.VertexAttrib3fv = (PFNGLVERTEXATTRIB3FVPROC)segl_vtable
-        ->GetProcAddress("glVertexAttrib3fv");
-    if (vtable.VertexAttrib3fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib3fv"
+    // NOTE: format 0 would reset the buffers to the window's default
+    // format, dropping the one eglCreateWindowSurface set from the config
+    EGLint format = 0;
+    if (egl_ctx.display != EGL_NO_DISPLAY) {
+        egl.GetConfigAttrib(
+            egl_ctx.display,
+            egl_ctx.config,
+            EGL_NATIVE_VISUAL_ID,
+            &format
         );
-        exit(1);
     }
-    vtable.VertexAttrib4f = (PFNGLVERTEXATTRIB4FPROC)segl_vtable->GetProcAddress(
-        "glVertexAttrib4f"
+    ANativeWindow_setBuffersGeometry(app->window, width, height, format);
+    geometry_width = width;
+    geometry_height = height;
+}
+
+static void window_measure(AndroidApp *app) {
+    // NOTE: the window reports its own size, which the buffer geometry
+    // leaves alone, so measuring needs no reset
+    segl_surface_window(
+        &surface,
+        ANativeWindow_getWidth(app->window),
+        ANativeWindow_getHeight(app->window)
     );
-    if (vtable.VertexAttrib4f == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib4f"
-        );
-        exit(1);
-    }
-    vtable.VertexAttrib4fv = (PFNGLVERTEXATTRIB4FVPROC)segl_vtable
-        ->GetProcAddress("glVertexAttrib4fv");
-    if (vtable.VertexAttrib4fv == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttrib4fv"
-        );
-        exit(1);
-    }
-    vtable.VertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)segl_vtable
-        ->GetProcAddress("glVertexAttribPointer");
-    if (vtable.VertexAttribPointer == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glVertexAttribPointer"
-        );
-        exit(1);
+}
+
+// The surface picks the new size up with its next buffer.
+static void scale_apply(AndroidApp *app) {
+    int32_t width = 0;
+    int32_t height = 0;
+    segl_scale_size(
+        &scale,
+        surface.window_width,
+        surface.window_height,
+        &width,
+        &height
+    );
+    if (width == surface.window_width && height == surface.window_height) {
+        width = 0;
+        height = 0;
+    }
+    geometry_apply(app, width, height);
+    segl_surface_invalidate(&surface);
+}
+
+static int64_t clock_ns(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+#ifdef SEGL_TRACE
+static void trace_swapped(int64_t swap_ns) {
+    if (
+        trace_swap_ns != 0 &&
+        swap_ns - trace_swap_ns > TRACE_HITCH_NS &&
+        (
+            trace_hitch_ns == 0 ||
+            swap_ns - trace_hitch_ns > TRACE_HITCH_INTERVAL_NS
+        )
+    ) {
+        SEGL_TRACE_INSTANT("hitch");
+        segl_trace_dump(trace_hitch_path);
+        trace_hitch_ns = swap_ns;
+        // NOTE: the dump stalls this thread, which is no hitch of the app
+        trace_swap_ns = 0;
+        return;
     }
-    vtable.Viewport = (PFNGLVIEWPORTPROC)segl_vtable->GetProcAddress(
-        "glViewport"
-    );
-    if (vtable.Viewport == NULL) {
-        __android_log_print(
-            ANDROID_LOG_ERROR,
-            SEGL_ANDROID_LOG_ID,
-            "failed to load glViewport"
-        );
-        exit(1);
+    trace_swap_ns = swap_ns;
+}
+#endif
+
+// Feeds the GPU time of frames whose timestamps resolved since tail.
+static void scale_update(AndroidApp *app, uint64_t tail) {
+    for (; tail < timing.tail; tail += 1) {
+        const SEglFrameTiming *frame = &timing.frames[
+            tail % SEGL_TIMING_RING_LEN
+        ];
+        if (frame->gpu_complete_ns < 0 || frame->swap_ns < scale_changed_ns) {
+            continue;
+        }
+        if (segl_scale_frame(&scale, frame->gpu_complete_ns - frame->swap_ns)) {
+            scale_changed_ns = clock_ns();
+            SEGL_TRACE_COUNTER(
+                "render scale %",
+                (int64_t)roundf(scale.scale * 100.0f)
+            );
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "render scale %.2f",
+                (double)scale.scale
+            );
+            scale_apply(app);
+        }
     }
-
-    return vtable;
 }
 
-static SEglVtable egl;
-static SEglCtx egl_ctx;
-static SGlVtable gl;
+#ifdef SEGL_TRACING
+// Trace section of each lifecycle command.
+static const char *app_cmd_name(int32_t cmd) {
+    static const char *const names[] = {
+        [APP_CMD_INPUT_CHANGED] = "APP_CMD_INPUT_CHANGED",
+        [APP_CMD_INIT_WINDOW] = "APP_CMD_INIT_WINDOW",
+        [APP_CMD_TERM_WINDOW] = "APP_CMD_TERM_WINDOW",
+        [APP_CMD_WINDOW_RESIZED] = "APP_CMD_WINDOW_RESIZED",
+        [APP_CMD_WINDOW_REDRAW_NEEDED] = "APP_CMD_WINDOW_REDRAW_NEEDED",
+        [APP_CMD_CONTENT_RECT_CHANGED] = "APP_CMD_CONTENT_RECT_CHANGED",
+        [APP_CMD_GAINED_FOCUS] = "APP_CMD_GAINED_FOCUS",
+        [APP_CMD_LOST_FOCUS] = "APP_CMD_LOST_FOCUS",
+        [APP_CMD_CONFIG_CHANGED] = "APP_CMD_CONFIG_CHANGED",
+        [APP_CMD_LOW_MEMORY] = "APP_CMD_LOW_MEMORY",
+        [APP_CMD_START] = "APP_CMD_START",
+        [APP_CMD_RESUME] = "APP_CMD_RESUME",
+        [APP_CMD_SAVE_STATE] = "APP_CMD_SAVE_STATE",
+        [APP_CMD_PAUSE] = "APP_CMD_PAUSE",
+        [APP_CMD_STOP] = "APP_CMD_STOP",
+        [APP_CMD_DESTROY] = "APP_CMD_DESTROY",
+    };
+    if (cmd < 0 || (size_t)cmd >= countof(names) || names[cmd] == NULL) {
+        return "handle_cmd";
+    }
+    return names[cmd];
+}
+#endif
 
 static void handle_cmd(AndroidApp *app, int32_t cmd) {
+    SEGL_TRACE_BEGIN(app_cmd_name(cmd));
     switch (cmd) {
         case APP_CMD_INIT_WINDOW:
-            __android_log_print(
+            SEGL_LOG(
                 ANDROID_LOG_INFO,
-                SEGL_ANDROID_LOG_ID,
                 "APP_CMD_INIT_WINDOW"
             );
+            if (egl_ctx.surface != EGL_NO_SURFACE) {
+                break;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &resume_start);
+            resume_pending = true;
+            // NOTE: a new window starts out with its own size
+            geometry_width = 0;
+            geometry_height = 0;
+            window_measure(app);
+            scale_apply(app);
+            if (recovery.pending != SEGL_LOSS_NONE) {
+                segl_ctx_recover(
+                    &egl_ctx,
+                    &recovery,
+                    SEGL_LOSS_NONE,
+                    app->window,
+                    &egl,
+                    &egl_config_spec
+                );
+                break;
+            }
             if (egl_ctx.display != EGL_NO_DISPLAY) {
+                // NOTE: a context kept across the background is the one
+                // most likely to have been lost
+                SEglLoss loss = segl_ctx_surface_load(
+                    &egl_ctx,
+                    app->window,
+                    &egl
+                );
+                if (loss == SEGL_LOSS_NONE) {
+                    segl_surface_invalidate(&surface);
+                    segl_surface_update(&surface, &egl_ctx, &egl);
+                    segl_timing_start(&timing, &egl_ctx, &egl, &ext);
+                } else {
+                    segl_ctx_recover(
+                        &egl_ctx,
+                        &recovery,
+                        loss,
+                        app->window,
+                        &egl,
+                        &egl_config_spec
+                    );
+                }
                 break;
             }
-            egl_ctx = segl_ctx_load(app, &egl);
+            egl_ctx = segl_ctx_load(app->window, &egl, &egl_config_spec);
+            segl_ctx_swap_mode(&egl_ctx, &egl, SWAP_MODE);
+            if (!ext.loaded) {
+                segl_ext_load(
+                    &ext,
+                    &egl,
+                    &gl,
+                    egl_ctx.display,
+                    egl_config_spec.cache
+                );
+                if (!egl_ctx.config_cached || !ext.caps_cached) {
+                    segl_cache_fill(
+                        &egl_cache,
+                        &egl,
+                        &gl,
+                        &egl_ctx,
+                        &egl_config_spec,
+                        &ext
+                    );
+                    segl_cache_write(&egl_cache, egl_cache_path);
+                }
+            }
+            segl_surface_reset(&surface);
+            segl_surface_update(&surface, &egl_ctx, &egl);
+            segl_upload_start(&uploader, &egl_ctx, &egl, &gl, &ext);
+            segl_timing_start(&timing, &egl_ctx, &egl, &ext);
+            break;
+        case APP_CMD_WINDOW_RESIZED:
+        case APP_CMD_CONFIG_CHANGED:
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                cmd == APP_CMD_WINDOW_RESIZED ?
+                    "APP_CMD_WINDOW_RESIZED" :
+                    "APP_CMD_CONFIG_CHANGED"
+            );
+            if (app->window != NULL) {
+                window_measure(app);
+                scale_apply(app);
+            }
+            break;
+        case APP_CMD_CONTENT_RECT_CHANGED:
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "APP_CMD_CONTENT_RECT_CHANGED"
+            );
+            segl_surface_content(
+                &surface,
+                app->contentRect.left,
+                app->contentRect.top,
+                app->contentRect.right,
+                app->contentRect.bottom
+            );
             break;
         case APP_CMD_TERM_WINDOW:
-            __android_log_print(
+            SEGL_LOG(
                 ANDROID_LOG_INFO,
-                SEGL_ANDROID_LOG_ID,
                 "APP_CMD_TERM_WINDOW"
             );
-            if (egl_ctx.display == EGL_NO_DISPLAY) {
-                break;
-            }
+#ifdef SEGL_TERM_CONTEXT
+            segl_upload_stop(&uploader);
             segl_ctx_unload(&egl_ctx, &egl);
+            hud_context_lost(&hud);
+            // NOTE: the next window loads everything afresh anyway
+            recovery.pending = SEGL_LOSS_NONE;
+#else
+            segl_ctx_surface_unload(&egl_ctx, &egl);
+#endif
             break;
         case APP_CMD_DESTROY:
-            __android_log_print(
+            SEGL_LOG(
                 ANDROID_LOG_INFO,
-                SEGL_ANDROID_LOG_ID,
                 "APP_CMD_DESTROY"
             );
+            segl_upload_stop(&uploader);
+            segl_ctx_unload(&egl_ctx, &egl);
+            hud_context_lost(&hud);
+            break;
+#ifdef SEGL_TRACE
+        case APP_CMD_PAUSE:
+            segl_trace_dump(trace_path);
             break;
+#endif
         default:
             break;
     }
+    SEGL_TRACE_END(app_cmd_name(cmd));
 }
 
-static int32_t handle_input(AndroidApp *app, AInputEvent *event) {
-    return 0;
+// Nothing to draw, so the looper may block until the next command.
+static bool app_idle(const AndroidApp *app) {
+    return (
+        egl_ctx.surface == EGL_NO_SURFACE ||
+        app->activityState != APP_CMD_RESUME
+    );
+}
+
+static void pacer_vsync(int64_t vsync_ns, void *userdata) {
+    SEGL_TRACE_INSTANT("vsync");
+    if (frame_pacer_vsync(&pacer, vsync_ns)) {
+        frame_ready = true;
+    }
+}
+
+static int frame_timer_callback(int fd, int events, void *data) {
+    int64_t vsync_ns = frame_timer_read(&frame_timer);
+    if (vsync_ns != 0) {
+        pacer_vsync(vsync_ns, NULL);
+    }
+    return 1;
+}
+
+// Keeps vsyncs coming while there is something to draw.
+static void pacer_request(bool active) {
+    if (!paced) {
+        return;
+    }
+    if (choreographer_loaded) {
+        if (active) {
+            choreographer_post(&choreographer);
+        }
+    } else if (active != frame_timer_armed) {
+        frame_timer_arm(&frame_timer, active);
+        frame_timer_armed = active;
+    }
+}
+
+static void pacer_load(AndroidApp *app) {
+    frame_pacer_init(&pacer, REFRESH_NS, SEGL_FRAME_DIVISOR);
+    paced = SWAP_MODE != SEGL_SWAP_UNTHROTTLED;
+    if (!paced) {
+        return;
+    }
+    choreographer_loaded = choreographer_load(
+        &choreographer,
+        pacer_vsync,
+        NULL
+    );
+    if (!choreographer_loaded) {
+        paced = (
+            frame_timer_open(&frame_timer, REFRESH_NS) &&
+            ALooper_addFd(
+                app->looper,
+                frame_timer.fd,
+                ALOOPER_POLL_CALLBACK,
+                ALOOPER_EVENT_INPUT,
+                frame_timer_callback,
+                NULL
+            ) == 1
+        );
+    }
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "frame pacing: %s, every %d vsync",
+        choreographer_loaded ? "choreographer" :
+            paced ? "timer" : "off",
+        SEGL_FRAME_DIVISOR
+    );
+}
+
+// Blocks while idle or waiting for the vsync that starts the next frame.
+static int app_wait_ms(const AndroidApp *app) {
+    bool idle = app_idle(app);
+    pacer_request(!idle);
+    // NOTE: a vsync that came in as the app went idle starts no frame
+    if (idle && frame_ready) {
+        frame_ready = false;
+        pacer.frame_pending = false;
+    }
+#ifdef SEGL_TRACE
+    // NOTE: the first frame after a stay in the background is no hitch
+    if (idle) {
+        trace_swap_ns = 0;
+    }
+#endif
+    // NOTE: a failed recovery is retried after a while, not spun on
+    if (recovery.pending != SEGL_LOSS_NONE && app->window != NULL) {
+        return RECOVERY_RETRY_MS;
+    }
+    return idle || (paced && !frame_ready) ? -1 : 0;
 }
 
-static inline int64_t time_since(TimeSpec end, TimeSpec start) {
-    int64_t seconds = (int64_t)end.tv_sec - (int64_t)start.tv_sec;
-    int64_t sec_diff = seconds * 1000L * 1000L * 1000L;
-    int64_t nsec_diff = (int64_t)end.tv_nsec - (int64_t)start.tv_nsec;
-    return sec_diff + nsec_diff;
+static int32_t handle_input(AndroidApp *app, AInputEvent *event) {
+    if (AInputEvent_getType(event) != AINPUT_EVENT_TYPE_MOTION) {
+        return 0;
+    }
+    switch (AMotionEvent_getAction(event) & AMOTION_EVENT_ACTION_MASK) {
+        case AMOTION_EVENT_ACTION_DOWN:
+            hud_tap_pointers = 1;
+            break;
+        case AMOTION_EVENT_ACTION_POINTER_DOWN:
+            if (AMotionEvent_getPointerCount(event) > hud_tap_pointers) {
+                hud_tap_pointers = AMotionEvent_getPointerCount(event);
+            }
+            break;
+        case AMOTION_EVENT_ACTION_UP:
+            if (
+                hud_tap_pointers == 3 &&
+                AMotionEvent_getEventTime(event) -
+                    AMotionEvent_getDownTime(event) < HUD_TAP_NS
+            ) {
+                hud_tap_pointers = 0;
+                hud_toggle(&hud);
+                return 1;
+            }
+            hud_tap_pointers = 0;
+            break;
+        case AMOTION_EVENT_ACTION_CANCEL:
+            hud_tap_pointers = 0;
+            break;
+        default:
+            break;
+    }
+    return 0;
 }
 
 void android_main(AndroidApp *app) {
-    __android_log_print(ANDROID_LOG_INFO, SEGL_ANDROID_LOG_ID, "android_main");
+    segl_log_start();
+    SEGL_LOG(ANDROID_LOG_INFO, "android_main");
+    SEGL_ATRACE_LOAD();
     app->onAppCmd = handle_cmd;
     app->onInputEvent = handle_input;
 
-    __android_log_print(
+#ifndef SEGL_DIRECT_LINK
+    SEGL_LOG(
         ANDROID_LOG_INFO,
-        SEGL_ANDROID_LOG_ID,
         "egl_vtable_load"
     );
-    egl = segl_vtable_load();
+    SProcStats egl_stats;
+    egl = segl_vtable_load(NULL, &egl_stats);
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "loaded %u EGL functions in %lld ns",
+        egl_stats.loaded,
+        (long long)egl_stats.load_ns
+    );
+
+    SEGL_LOG(ANDROID_LOG_INFO, "gl_vtable_load");
+    SProcStats gl_stats;
+    sgl_vtable_load(&gl, &egl, &gl_stats);
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "loaded %u GL functions in %lld ns",
+        gl_stats.loaded,
+        (long long)gl_stats.load_ns
+    );
 
-    __android_log_print(ANDROID_LOG_INFO, SEGL_ANDROID_LOG_ID, "gl_vtable_load");
-    gl = sgl_vtable_load(&egl);
+#endif // SEGL_DIRECT_LINK
+
+    snprintf(
+        egl_cache_path,
+        sizeof(egl_cache_path),
+        "%s/segl_cache.bin",
+        app->activity->internalDataPath
+    );
+    if (segl_cache_read(&egl_cache, egl_cache_path)) {
+        egl_config_spec.cache = &egl_cache;
+    }
+#ifdef SEGL_TRACE
+    snprintf(
+        trace_path,
+        sizeof(trace_path),
+        "%s/segl_trace.json",
+        app->activity->internalDataPath
+    );
+    snprintf(
+        trace_hitch_path,
+        sizeof(trace_hitch_path),
+        "%s/segl_trace_hitch.json",
+        app->activity->internalDataPath
+    );
+#endif
 
     egl_ctx = (SEglCtx){
         .display = EGL_NO_DISPLAY,
         .context = EGL_NO_CONTEXT,
         .surface = EGL_NO_SURFACE,
     };
-
-    float red = 0.66f;
-    float green = 0.33f;
-    float blue = 0.0f;
-
-    bool red_flip = false;
-    bool green_flip = false;
-    bool blue_flip = false;
-
-    int64_t elapsed = 0;
-    TimeSpec last;
-    clock_gettime(CLOCK_MONOTONIC, &last);
+    segl_recovery_register(&recovery, recovery_lost, recovery_restore, NULL);
+    segl_surface_init(&surface);
+    segl_surface_on_resize(&surface, surface_resized, NULL);
+    segl_scale_init(&scale, SCALE_TARGET_NS, SCALE_MIN, SCALE_MAX);
+    hud_init(&hud, SCALE_TARGET_NS);
+    pacer_load(app);
+#ifdef SEGL_RENDER_SCALE
+    segl_scale_pin(&scale, SEGL_RENDER_SCALE);
+#endif
+
+    Scene scene;
+    scene_init(&scene);
+    Scene scene_prev = scene;
+    FixedStep step;
+    fixed_step_init(
+        &step,
+        TIMESTEP,
+        MAX_STEPS_PER_FRAME,
+        FIXED_STEP_FAST_FORWARD
+    );
+
+    int64_t last_ns = clock_ns();
+    int64_t swap_end_ns = last_ns;
+    FRAME_STATS_START(&frame_stats, TIMING_REPORT_FRAMES);
+    FRAME_STATS_BEGIN(&frame_stats, FRAME_PHASE_POLL);
+    SEGL_TRACE_BEGIN("poll");
+
+#ifdef SEGL_UNTHROTTLED
+    long report_frames = 0;
+    TimeSpec report_start;
+    clock_gettime(CLOCK_MONOTONIC, &report_start);
+    TimeSpec report_cpu_start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &report_cpu_start);
+#endif
 
     for (;;) {
-        TimeSpec now;
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        elapsed += time_since(now, last);
-        last = now;
-
-        while (elapsed >= TIMESTEP) {
-            red += 0.005f;
-            green += 0.006f;
-            blue += 0.007f;
-            if (red >= 1.0f) {
-                red -= 1.0f;
-                red_flip = !red_flip;
+        // NOTE: while idle or before the next paced vsync the looper
+        // blocks until a command, input or vsync arrives, then drains the
+        // rest without blocking once a frame can start
+        int events;
+        AndroidPollSource *source;
+        int wait_ms = app_wait_ms(app);
+        for (;;) {
+            int ident = ALooper_pollOnce(
+                wait_ms,
+                NULL,
+                &events,
+                (void **)&source
+            );
+            if (ident == ALOOPER_POLL_TIMEOUT || ident == ALOOPER_POLL_ERROR) {
+                break;
             }
-            if (green >= 1.0f) {
-                green -= 1.0f;
-                green_flip = !green_flip;
+            if (ident >= 0 && source != NULL) {
+                source->process(app, source);
             }
-            if (blue >= 1.0f) {
-                blue -= 1.0f;
-                blue_flip = !blue_flip;
+            if (app->destroyRequested) {
+                FRAME_STATS_STOP(&frame_stats);
+                segl_log_flush();
+                return;
             }
-            elapsed -= TIMESTEP;
+            wait_ms = app_wait_ms(app);
+        }
+        if (recovery.pending != SEGL_LOSS_NONE && app->window != NULL) {
+            segl_ctx_recover(
+                &egl_ctx,
+                &recovery,
+                SEGL_LOSS_NONE,
+                app->window,
+                &egl,
+                &egl_config_spec
+            );
+        }
+        if (app_idle(app) || (paced && !frame_ready)) {
+            continue;
+        }
+        FRAME_STATS_END(&frame_stats, FRAME_PHASE_POLL);
+        FRAME_STATS_BEGIN(&frame_stats, FRAME_PHASE_ISSUE);
+        SEGL_TRACE_END("poll");
+        SEGL_TRACE_BEGIN("issue");
+        int64_t issue_start_ns = clock_ns();
+
+        // NOTE: the scene only moves on frames, paced ones at their vsync,
+        // and fast-forwards whatever time passed in between
+        int64_t frame_ns = paced ? pacer.frame_vsync_ns : clock_ns();
+        uint64_t skipped = 0;
+        int steps = fixed_step_advance(
+            &step,
+            frame_ns > last_ns ? frame_ns - last_ns : 0,
+            &skipped
+        );
+        last_ns = frame_ns > last_ns ? frame_ns : last_ns;
+        scene_advance(&scene, skipped);
+        for (int i = 0; i < steps; i += 1) {
+            scene_prev = scene;
+            scene_step(&scene);
         }
 
-        int events;
-        AndroidPollSource *source;
-        while (ALooper_pollOnce(0, 0, &events, (void **)&source) >= 0) {
-            if (source != NULL) {
-                source->process(app, source);
+        // NOTE: the clear color animates, so every frame damages the whole
+        // surface; partial redraws only need segl_damage_add instead
+        segl_damage_invalidate(&damage);
+        segl_damage_begin(&damage, &egl_ctx, &egl, &ext);
+
+        scene_draw(&scene_prev, &scene, fixed_step_alpha(&step), &gl);
+        hud_draw(&hud, &surface.content, surface.width, surface.height, &gl);
+
+        // NOTE: paced frames ask to be shown at their deadline, so at 30 or
+        // 20 fps each stays up for the same number of vsyncs
+        segl_timing_frame(
+            &timing,
+            &egl_ctx,
+            &ext,
+            paced ? frame_pacer_deadline(&pacer) : 0
+        );
+        FRAME_STATS_END(&frame_stats, FRAME_PHASE_ISSUE);
+        FRAME_STATS_BEGIN(&frame_stats, FRAME_PHASE_SWAP);
+        SEGL_TRACE_END("issue");
+        SEGL_TRACE_BEGIN("swap");
+        int64_t swap_start_ns = clock_ns();
+        SEglLoss loss = segl_loss_check(
+            segl_damage_swap(&damage, &egl_ctx, &egl, &ext),
+            &egl
+        );
+        FRAME_STATS_END(&frame_stats, FRAME_PHASE_SWAP);
+        SEGL_TRACE_END("swap");
+        int64_t last_swap_end_ns = swap_end_ns;
+        swap_end_ns = clock_ns();
+        hud_frame(
+            &hud,
+            &(HudFrame){
+                .frame_ns = swap_end_ns - last_swap_end_ns,
+                .phase_ns = {
+                    [FRAME_PHASE_POLL] = issue_start_ns - last_swap_end_ns,
+                    [FRAME_PHASE_ISSUE] = swap_start_ns - issue_start_ns,
+                    [FRAME_PHASE_SWAP] = swap_end_ns - swap_start_ns,
+                },
+            },
+            swap_end_ns
+        );
+#ifdef SEGL_TRACE
+        trace_swapped(swap_end_ns);
+#endif
+        if (paced) {
+            frame_pacer_frame_done(&pacer, swap_end_ns);
+            frame_ready = false;
+            SEGL_TRACE_COUNTER("missed deadlines", (int64_t)pacer.missed);
+            if (pacer.frames % TIMING_REPORT_FRAMES == 0) {
+                SEGL_LOG(
+                    ANDROID_LOG_INFO,
+                    "paced %llu frames every %d vsync at %lld ns refresh: "
+                    "%llu missed deadlines, %llu vsyncs skipped",
+                    (unsigned long long)pacer.frames,
+                    pacer.divisor,
+                    (long long)pacer.refresh_ns,
+                    (unsigned long long)pacer.missed,
+                    (unsigned long long)pacer.skipped
+                );
             }
         }
-
-        if (egl_ctx.display == EGL_NO_DISPLAY) {
-            const struct timespec duration = { .tv_nsec = TIMESTEP };
-            nanosleep(&duration, NULL);
+        if (loss != SEGL_LOSS_NONE) {
+            segl_ctx_recover(
+                &egl_ctx,
+                &recovery,
+                loss,
+                app->window,
+                &egl,
+                &egl_config_spec
+            );
+            FRAME_STATS_BEGIN(&frame_stats, FRAME_PHASE_POLL);
+            SEGL_TRACE_BEGIN("poll");
             continue;
         }
+        segl_surface_update(&surface, &egl_ctx, &egl);
+        // NOTE: the first frame after a resume spans the stay in the
+        // background; other modes than adaptive ignore the frame time
+        if (!resume_pending) {
+            segl_ctx_swap_adapt(
+                &egl_ctx,
+                &egl,
+                swap_end_ns - last_swap_end_ns,
+                pacer.refresh_ns * pacer.divisor
+            );
+        }
+        uint64_t timing_tail = timing.tail;
+        segl_timing_poll(&timing, &egl_ctx, &ext);
+        scale_update(app, timing_tail);
+        // NOTE: head stalls while the ring waits for timestamps and
+        // restarts from 0 on a new surface
+        if (timing.head < timing_reported) {
+            timing_reported = 0;
+        }
+        if (
+            timing.enabled &&
+            timing.head - timing_reported >= TIMING_REPORT_FRAMES
+        ) {
+            timing_reported = timing.head;
+            SEglTimingReport report;
+            segl_timing_report(&timing, &report);
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "swap to present over %zu frames: p50 %lld p90 %lld "
+                "p99 %lld max %lld us, gpu p50 %lld us",
+                report.frames,
+                (long long)(report.swap_to_present.p50 / 1000),
+                (long long)(report.swap_to_present.p90 / 1000),
+                (long long)(report.swap_to_present.p99 / 1000),
+                (long long)(report.swap_to_present.max / 1000),
+                (long long)(report.swap_to_gpu_complete.p50 / 1000)
+            );
+        }
 
-        int width = ANativeWindow_getWidth(app->window);
-        int height = ANativeWindow_getHeight(app->window);
+        segl_upload_poll(&uploader, UPLOAD_HANDOVERS_PER_FRAME);
+
+#ifdef SEGL_UNTHROTTLED
+        report_frames += 1;
+        TimeSpec report_end;
+        clock_gettime(CLOCK_MONOTONIC, &report_end);
+        int64_t report_ns = time_since(report_end, report_start);
+        if (report_ns >= 1000L * 1000L * 1000L) {
+            TimeSpec report_cpu_end;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &report_cpu_end);
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "unthrottled: %.1f fps, %lld ns CPU per frame",
+                (double)report_frames * 1e9 / (double)report_ns,
+                (long long)(
+                    time_since(report_cpu_end, report_cpu_start) /
+                    report_frames
+                )
+            );
+            report_frames = 0;
+            report_start = report_end;
+            report_cpu_start = report_cpu_end;
+        }
+#endif
 
-        gl.Viewport(0, 0, width, height);
-        gl.ClearColor(
-            red_flip ? 1.0f - red : red,
-            green_flip ? 1.0f - green : green,
-            blue_flip ? 1.0f - blue : blue,
-            1.0f
-        );
-        gl.Clear(GL_COLOR_BUFFER_BIT);
+        if (resume_pending) {
+            TimeSpec first_frame;
+            clock_gettime(CLOCK_MONOTONIC, &first_frame);
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "resume to first frame: %lld ns",
+                (long long)time_since(first_frame, resume_start)
+            );
+            resume_pending = false;
+        }
 
-        egl.SwapBuffers(egl_ctx.display, egl_ctx.surface);
+        FRAME_STATS_FRAME(&frame_stats);
+        FRAME_STATS_BEGIN(&frame_stats, FRAME_PHASE_POLL);
+        SEGL_TRACE_BEGIN("poll");
     }
 }
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "scene.h"
+#include "segl.h"
+
+void scene_init(Scene *scene) {
+    *scene = (Scene){
+        .red = 0.66f,
+        .green = 0.33f,
+        .blue = 0.0f,
+    };
+}
+
+#define SCENE_RED_STEP 0.005f
+#define SCENE_GREEN_STEP 0.006f
+#define SCENE_BLUE_STEP 0.007f
+
+// NOTE: each channel flips once per whole unit it wraps around
+static void scene_channel_advance(
+    float *value,
+    bool *flip,
+    float step,
+    uint64_t steps
+) {
+    double total = (double)*value + (double)step * (double)steps;
+    double wraps = floor(total);
+    *value = (float)(total - wraps);
+    if (fmod(wraps, 2.0) != 0.0) {
+        *flip = !*flip;
+    }
+}
+
+void scene_advance(Scene *scene, uint64_t steps) {
+    scene_channel_advance(
+        &scene->red,
+        &scene->red_flip,
+        SCENE_RED_STEP,
+        steps
+    );
+    scene_channel_advance(
+        &scene->green,
+        &scene->green_flip,
+        SCENE_GREEN_STEP,
+        steps
+    );
+    scene_channel_advance(
+        &scene->blue,
+        &scene->blue_flip,
+        SCENE_BLUE_STEP,
+        steps
+    );
+}
+
+void scene_step(Scene *scene) {
+    scene->red += SCENE_RED_STEP;
+    scene->green += SCENE_GREEN_STEP;
+    scene->blue += SCENE_BLUE_STEP;
+    if (scene->red >= 1.0f) {
+        scene->red -= 1.0f;
+        scene->red_flip = !scene->red_flip;
+    }
+    if (scene->green >= 1.0f) {
+        scene->green -= 1.0f;
+        scene->green_flip = !scene->green_flip;
+    }
+    if (scene->blue >= 1.0f) {
+        scene->blue -= 1.0f;
+        scene->blue_flip = !scene->blue_flip;
+    }
+}
+
+void scene_color(const Scene *scene, float *rgb) {
+    rgb[0] = scene->red_flip ? 1.0f - scene->red : scene->red;
+    rgb[1] = scene->green_flip ? 1.0f - scene->green : scene->green;
+    rgb[2] = scene->blue_flip ? 1.0f - scene->blue : scene->blue;
+}
+
+void scene_interpolate(
+    const Scene *prev,
+    const Scene *scene,
+    float alpha,
+    float *rgb
+) {
+    // NOTE: the channels bounce between 0 and 1 without jumps, so the
+    // colors blend linearly even across a flip
+    float from[3];
+    scene_color(prev, from);
+    scene_color(scene, rgb);
+    for (int i = 0; i < 3; i += 1) {
+        rgb[i] = from[i] + (rgb[i] - from[i]) * alpha;
+    }
+}
+
+void scene_draw(
+    const Scene *prev,
+    const Scene *scene,
+    float alpha,
+    const SGlVtable *sgl_vtable
+) {
+    float rgb[3];
+    scene_interpolate(prev, scene, alpha, rgb);
+
+    SGL_CALL(sgl_vtable, ClearColor)(rgb[0], rgb[1], rgb[2], 1.0f);
+    SGL_CALL(sgl_vtable, Clear)(GL_COLOR_BUFFER_BIT);
+}
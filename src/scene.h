@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl.h"
+
+// The app's frame content, shared by android_main and the headless runner
+// so both exercise the same render path.
+typedef struct {
+    float red;
+    float green;
+    float blue;
+    bool red_flip;
+    bool green_flip;
+    bool blue_flip;
+} Scene;
+
+void scene_init(Scene *scene);
+// Advances the animation by one fixed timestep.
+void scene_step(Scene *scene);
+// Advances by any number of steps in constant time, matching that many
+// scene_step calls up to float rounding.
+void scene_advance(Scene *scene, uint64_t steps);
+// The scene's clear color.
+void scene_color(const Scene *scene, float *rgb);
+// The clear color alpha of the way from prev to scene, one step apart.
+void scene_interpolate(
+    const Scene *prev,
+    const Scene *scene,
+    float alpha,
+    float *rgb
+);
+// Draws the scene interpolated from prev into the current viewport, which
+// the caller sets on resize.
+void scene_draw(
+    const Scene *prev,
+    const Scene *scene,
+    float alpha,
+    const SGlVtable *sgl_vtable
+);
+
+#endif // SCENE_H
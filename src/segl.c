@@ -0,0 +1,1309 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlfcn.h>
+
+#include "segl.h"
+#include "segl_log.h"
+#include "segl_trace.h"
+
+#ifndef SEGL_DIRECT_LINK
+
+typedef SProc (*SProcLookup)(void *userdata, const char *name);
+
+typedef struct {
+    const char *name;
+    size_t offset;
+    bool required;
+} SProcDesc;
+
+// Resolves every entry of a descriptor table into the vtable at the given
+// offsets. Every missing symbol is reported before returning the number of
+// missing required symbols, so callers can fail once with the full picture.
+static uint32_t sproc_table_load(
+    void *vtable,
+    const SProcDesc *descs,
+    size_t ndescs,
+    SProcLookup lookup,
+    void *userdata,
+    SProcStats *stats
+) {
+    TimeSpec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    uint32_t loaded = 0;
+    uint32_t missing = 0;
+    uint32_t missing_required = 0;
+    for (size_t i = 0; i < ndescs; i += 1) {
+        SProc proc = lookup(userdata, descs[i].name);
+        memcpy((char *)vtable + descs[i].offset, &proc, sizeof(proc));
+        if (proc != NULL) {
+            loaded += 1;
+            continue;
+        }
+
+        missing += 1;
+        if (descs[i].required) {
+            missing_required += 1;
+            SEGL_LOG(
+                ANDROID_LOG_ERROR,
+                "failed to load %s",
+                descs[i].name
+            );
+        }
+    }
+
+    TimeSpec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (stats != NULL) {
+        stats->load_ns = time_since(end, start);
+        stats->loaded = loaded;
+        stats->missing = missing;
+    }
+
+    return missing_required;
+}
+
+static const SProcDesc segl_proc_descs[] = {
+#define X(type, name, required) \
+    { "egl" #name, offsetof(SEglVtable, name), required },
+    SEGL_EGL_PROCS(X)
+#undef X
+};
+
+static SProc segl_dlsym_lookup(void *so_handle, const char *name) {
+    return (SProc)dlsym(so_handle, name);
+}
+
+SEglVtable segl_vtable_load(const char *path, SProcStats *stats) {
+    if (path == NULL) {
+        path = SEGL_LIBEGL_NAME;
+    }
+    SEGL_TRACE_BEGIN("segl_vtable_load");
+
+    void *so_handle = dlopen(path, RTLD_LAZY | RTLD_LOCAL);
+    if (so_handle == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to load %s: %s",
+            path,
+            dlerror()
+        );
+        exit(1);
+    }
+
+    SEglVtable vtable = { 0 };
+    uint32_t missing = sproc_table_load(
+        &vtable,
+        segl_proc_descs,
+        countof(segl_proc_descs),
+        segl_dlsym_lookup,
+        so_handle,
+        stats
+    );
+    if (missing > 0) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to load %u EGL functions",
+            missing
+        );
+        exit(1);
+    }
+
+    SEGL_TRACE_END("segl_vtable_load");
+    return vtable;
+}
+
+#endif // SEGL_DIRECT_LINK
+
+static const char *const segl_config_policy_names[] = {
+    [SEGL_CONFIG_PERFORMANCE] = "performance",
+    [SEGL_CONFIG_QUALITY] = "quality",
+    [SEGL_CONFIG_EXACT] = "exact",
+};
+
+static const struct {
+    EGLint attrib;
+    size_t offset;
+} segl_config_attrib_descs[] = {
+    { EGL_CONFIG_ID, offsetof(SEglConfigAttribs, config_id) },
+    { EGL_RED_SIZE, offsetof(SEglConfigAttribs, red) },
+    { EGL_GREEN_SIZE, offsetof(SEglConfigAttribs, green) },
+    { EGL_BLUE_SIZE, offsetof(SEglConfigAttribs, blue) },
+    { EGL_ALPHA_SIZE, offsetof(SEglConfigAttribs, alpha) },
+    { EGL_DEPTH_SIZE, offsetof(SEglConfigAttribs, depth) },
+    { EGL_STENCIL_SIZE, offsetof(SEglConfigAttribs, stencil) },
+    { EGL_SAMPLES, offsetof(SEglConfigAttribs, samples) },
+    { EGL_SURFACE_TYPE, offsetof(SEglConfigAttribs, surface_type) },
+    { EGL_RENDERABLE_TYPE, offsetof(SEglConfigAttribs, renderable_type) },
+    { EGL_COLOR_BUFFER_TYPE, offsetof(SEglConfigAttribs, color_buffer_type) },
+    { EGL_CONFIG_CAVEAT, offsetof(SEglConfigAttribs, caveat) },
+};
+
+static int64_t segl_config_distance(EGLint have, EGLint want) {
+    if (want == EGL_DONT_CARE) {
+        return 0;
+    }
+    return have > want ? have - want : want - have;
+}
+
+int64_t segl_config_score(
+    const SEglConfigAttribs *config,
+    const SEglConfigSpec *spec
+) {
+    if (
+        (config->surface_type & spec->surface_type) != spec->surface_type ||
+        (config->renderable_type & EGL_OPENGL_ES2_BIT) == 0 ||
+        config->color_buffer_type != EGL_RGB_BUFFER ||
+        config->caveat == EGL_NON_CONFORMANT_CONFIG
+    ) {
+        return SEGL_CONFIG_REJECT;
+    }
+
+    int64_t color = config->red + config->green + config->blue;
+    int64_t slow = config->caveat == EGL_SLOW_CONFIG ? 1 << 24 : 0;
+    switch (spec->policy) {
+        case SEGL_CONFIG_PERFORMANCE:
+            // NOTE: every sample, depth/stencil bit and color bit costs fill
+            // rate and bandwidth, with MSAA by far the most expensive
+            return -slow - config->samples * 4096 -
+                (config->depth + config->stencil) * 64 -
+                (color + config->alpha) * 16;
+        case SEGL_CONFIG_QUALITY:
+            return -slow + config->samples * 65536 + color * 1024 +
+                config->alpha * 64 + config->depth * 4 + config->stencil;
+        case SEGL_CONFIG_EXACT: {
+            const SEglConfigAttribs *want = &spec->exact;
+            return -slow -
+                segl_config_distance(config->red, want->red) -
+                segl_config_distance(config->green, want->green) -
+                segl_config_distance(config->blue, want->blue) -
+                segl_config_distance(config->alpha, want->alpha) -
+                segl_config_distance(config->depth, want->depth) -
+                segl_config_distance(config->stencil, want->stencil) -
+                segl_config_distance(config->samples, want->samples) * 64;
+        }
+    }
+
+    return SEGL_CONFIG_REJECT;
+}
+
+int segl_config_select(
+    const SEglConfigAttribs *configs,
+    int nconfigs,
+    const SEglConfigSpec *spec
+) {
+    int best = -1;
+    int64_t best_score = SEGL_CONFIG_REJECT;
+    for (int i = 0; i < nconfigs; i += 1) {
+        int64_t score = segl_config_score(&configs[i], spec);
+        if (score > best_score) {
+            best = i;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+static void segl_config_attribs_query(
+    const SEglVtable *segl_vtable,
+    EGLDisplay display,
+    EGLConfig config,
+    SEglConfigAttribs *attribs
+) {
+    for (size_t i = 0; i < countof(segl_config_attrib_descs); i += 1) {
+        EGLint value = 0;
+        segl_vtable->GetConfigAttrib(
+            display,
+            config,
+            segl_config_attrib_descs[i].attrib,
+            &value
+        );
+        memcpy(
+            (char *)attribs + segl_config_attrib_descs[i].offset,
+            &value,
+            sizeof(value)
+        );
+    }
+}
+
+// Enumerates every config of the display and returns the best one under
+// the spec's policy, or NULL when no config is acceptable.
+static EGLConfig segl_config_choose(
+    const SEglVtable *segl_vtable,
+    EGLDisplay display,
+    const SEglConfigSpec *spec,
+    SEglConfigAttribs *chosen
+) {
+    EGLint nconfigs = 0;
+    if (
+        !segl_vtable->GetConfigs(display, NULL, 0, &nconfigs) ||
+        nconfigs <= 0
+    ) {
+        return NULL;
+    }
+
+    EGLConfig *configs = malloc((size_t)nconfigs * sizeof(*configs));
+    SEglConfigAttribs *attribs = malloc((size_t)nconfigs * sizeof(*attribs));
+    if (configs == NULL || attribs == NULL) {
+        free(configs);
+        free(attribs);
+        return NULL;
+    }
+
+    EGLConfig config = NULL;
+    if (segl_vtable->GetConfigs(display, configs, nconfigs, &nconfigs)) {
+        for (EGLint i = 0; i < nconfigs; i += 1) {
+            segl_config_attribs_query(
+                segl_vtable,
+                display,
+                configs[i],
+                &attribs[i]
+            );
+        }
+
+        int best = segl_config_select(attribs, nconfigs, spec);
+        if (best >= 0) {
+            config = configs[best];
+            *chosen = attribs[best];
+            SEGL_LOG(
+                ANDROID_LOG_INFO,
+                "%s config policy chose config %d of %d: "
+                "r%d g%d b%d a%d depth %d stencil %d samples %d",
+                segl_config_policy_names[spec->policy],
+                chosen->config_id,
+                nconfigs,
+                chosen->red,
+                chosen->green,
+                chosen->blue,
+                chosen->alpha,
+                chosen->depth,
+                chosen->stencil,
+                chosen->samples
+            );
+        }
+    }
+
+    free(configs);
+    free(attribs);
+    return config;
+}
+
+// Copies a driver string, truncating it to the cache's fixed width.
+static void segl_cache_str_copy(char *dst, const char *src) {
+    if (src == NULL) {
+        src = "";
+    }
+    strncpy(dst, src, SEGL_CACHE_STR_LEN - 1);
+    dst[SEGL_CACHE_STR_LEN - 1] = '\0';
+}
+
+static bool segl_cache_str_eq(const char *cached, const char *current) {
+    char value[SEGL_CACHE_STR_LEN];
+    segl_cache_str_copy(value, current);
+    return strcmp(cached, value) == 0;
+}
+
+// NOTE: EGL_CONFIG_ID makes eglChooseConfig ignore every other attribute,
+// so this is a single lookup instead of an enumeration
+EGLConfig segl_config_from_cache(
+    const SEglVtable *segl_vtable,
+    EGLDisplay display,
+    const SEglConfigSpec *spec,
+    SEglConfigAttribs *chosen
+) {
+    const SEglCache *cache = spec->cache;
+    if (
+        cache->policy != spec->policy ||
+        cache->surface_type != spec->surface_type ||
+        (
+            spec->policy == SEGL_CONFIG_EXACT &&
+            memcmp(&cache->exact, &spec->exact, sizeof(spec->exact)) != 0
+        ) ||
+        !segl_cache_str_eq(
+            cache->egl_vendor,
+            segl_vtable->QueryString(display, EGL_VENDOR)
+        ) ||
+        !segl_cache_str_eq(
+            cache->egl_version,
+            segl_vtable->QueryString(display, EGL_VERSION)
+        )
+    ) {
+        return NULL;
+    }
+
+    const EGLint attribs[] = {
+        EGL_CONFIG_ID, cache->attribs.config_id,
+        EGL_NONE,
+    };
+    EGLConfig config = NULL;
+    EGLint nconfigs = 0;
+    if (
+        !segl_vtable->ChooseConfig(display, attribs, &config, 1, &nconfigs) ||
+        nconfigs != 1
+    ) {
+        return NULL;
+    }
+
+    *chosen = cache->attribs;
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "%s config policy reused cached config %d",
+        segl_config_policy_names[spec->policy],
+        chosen->config_id
+    );
+    return config;
+}
+
+SEglLoss segl_ctx_surface_load(
+    SEglCtx *segl_ctx,
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable
+) {
+    segl_ctx->surface = segl_vtable->CreateWindowSurface(
+        segl_ctx->display,
+        segl_ctx->config,
+        window,
+        NULL
+    );
+    if (segl_ctx->surface == EGL_NO_SURFACE) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to create EGL surface: 0x%x",
+            segl_vtable->GetError()
+        );
+        return SEGL_LOSS_SURFACE;
+    }
+
+    EGLBoolean current = segl_vtable->MakeCurrent(
+        segl_ctx->display,
+        segl_ctx->surface,
+        segl_ctx->surface,
+        segl_ctx->context
+    );
+    SEglLoss loss = segl_loss_check(current, segl_vtable);
+    if (!current) {
+        if (loss != SEGL_LOSS_CONTEXT) {
+            SEGL_LOG(
+                ANDROID_LOG_ERROR,
+                "failed to set EGL surface and context"
+            );
+            loss = SEGL_LOSS_SURFACE;
+        }
+        segl_vtable->DestroySurface(segl_ctx->display, segl_ctx->surface);
+        segl_ctx->surface = EGL_NO_SURFACE;
+        return loss;
+    }
+
+    // NOTE: the swap interval belongs to the surface, so a new surface
+    // starts back at the default of 1
+    if (segl_ctx->swap_interval != 1) {
+        segl_vtable->SwapInterval(segl_ctx->display, segl_ctx->swap_interval);
+    }
+    return SEGL_LOSS_NONE;
+}
+
+void segl_ctx_surface_unload(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable
+) {
+    if (segl_ctx->display == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    segl_vtable->MakeCurrent(
+        segl_ctx->display,
+        EGL_NO_SURFACE,
+        EGL_NO_SURFACE,
+        EGL_NO_CONTEXT
+    );
+
+    if (segl_ctx->surface != EGL_NO_SURFACE) {
+        segl_vtable->DestroySurface(segl_ctx->display, segl_ctx->surface);
+    }
+
+    segl_ctx->surface = EGL_NO_SURFACE;
+}
+
+static EGLDisplay segl_display_load(const SEglVtable *segl_vtable) {
+    EGLDisplay display = segl_vtable->GetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to find EGL display"
+        );
+        return EGL_NO_DISPLAY;
+    }
+
+    EGLint major;
+    EGLint minor;
+    if (!segl_vtable->Initialize(display, &major, &minor)) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to initialize EGL display"
+        );
+        return EGL_NO_DISPLAY;
+    }
+    return display;
+}
+
+// Chooses the config and creates the context on an initialized display,
+// leaving the context without a surface. Returns false if either fails.
+static bool segl_ctx_context_load(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+) {
+    segl_ctx->config = NULL;
+    if (spec->cache != NULL) {
+        segl_ctx->config = segl_config_from_cache(
+            segl_vtable,
+            segl_ctx->display,
+            spec,
+            &segl_ctx->attribs
+        );
+    }
+    segl_ctx->config_cached = segl_ctx->config != NULL;
+    if (segl_ctx->config == NULL) {
+        segl_ctx->config = segl_config_choose(
+            segl_vtable,
+            segl_ctx->display,
+            spec,
+            &segl_ctx->attribs
+        );
+    }
+    if (segl_ctx->config == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to find EGL config"
+        );
+        return false;
+    }
+
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION,
+        2,
+        EGL_CONTEXT_MINOR_VERSION,
+        0,
+        EGL_NONE,
+    };
+    segl_ctx->context = segl_vtable->CreateContext(
+        segl_ctx->display,
+        segl_ctx->config,
+        EGL_NO_CONTEXT,
+        context_attribs
+    );
+    if (segl_ctx->context == EGL_NO_CONTEXT) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to create EGL context"
+        );
+        return false;
+    }
+    segl_ctx->surface = EGL_NO_SURFACE;
+    segl_ctx->swap_mode = SEGL_SWAP_VSYNC;
+    segl_ctx->swap_interval = 1;
+    return true;
+}
+
+// Loads the display, context and surface into segl_ctx. On failure
+// returns false with whatever was created unloaded again, leaving
+// segl_ctx untouched.
+static bool segl_ctx_rebuild(
+    SEglCtx *segl_ctx,
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+) {
+    SEglCtx rebuilt = {
+        .display = segl_display_load(segl_vtable),
+        .context = EGL_NO_CONTEXT,
+        .surface = EGL_NO_SURFACE,
+    };
+    if (rebuilt.display == EGL_NO_DISPLAY) {
+        return false;
+    }
+    if (
+        !segl_ctx_context_load(&rebuilt, segl_vtable, spec) ||
+        segl_ctx_surface_load(&rebuilt, window, segl_vtable) != SEGL_LOSS_NONE
+    ) {
+        segl_ctx_unload(&rebuilt, segl_vtable);
+        return false;
+    }
+    *segl_ctx = rebuilt;
+    return true;
+}
+
+SEglCtx segl_ctx_load(
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+) {
+    SEGL_TRACE_BEGIN("segl_ctx_load");
+    SEglCtx segl_ctx;
+    if (!segl_ctx_rebuild(&segl_ctx, window, segl_vtable, spec)) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to load EGL"
+        );
+        exit(1);
+    }
+    SEGL_TRACE_END("segl_ctx_load");
+    return segl_ctx;
+}
+
+void segl_ctx_unload(SEglCtx *segl_ctx, const SEglVtable *segl_vtable) {
+    if (segl_ctx->display == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    segl_ctx_surface_unload(segl_ctx, segl_vtable);
+
+    if (segl_ctx->context != EGL_NO_CONTEXT) {
+        segl_vtable->DestroyContext(segl_ctx->display, segl_ctx->context);
+    }
+
+    segl_vtable->Terminate(segl_ctx->display);
+
+    segl_ctx->display = EGL_NO_DISPLAY;
+    segl_ctx->context = EGL_NO_CONTEXT;
+}
+
+static bool segl_ctx_swap_interval(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    EGLint interval
+) {
+    EGLint min_interval = 1;
+    EGLint max_interval = 1;
+    segl_vtable->GetConfigAttrib(
+        segl_ctx->display,
+        segl_ctx->config,
+        EGL_MIN_SWAP_INTERVAL,
+        &min_interval
+    );
+    segl_vtable->GetConfigAttrib(
+        segl_ctx->display,
+        segl_ctx->config,
+        EGL_MAX_SWAP_INTERVAL,
+        &max_interval
+    );
+    if (interval < min_interval) {
+        interval = min_interval;
+    }
+    if (interval > max_interval) {
+        interval = max_interval;
+    }
+
+    // NOTE: without a surface the interval is applied by the next
+    // segl_ctx_surface_load
+    if (
+        segl_ctx->surface != EGL_NO_SURFACE &&
+        !segl_vtable->SwapInterval(segl_ctx->display, interval)
+    ) {
+        return false;
+    }
+    segl_ctx->swap_interval = interval;
+    return true;
+}
+
+bool segl_ctx_swap_mode(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    SEglSwapMode mode
+) {
+    static const EGLint intervals[] = {
+        [SEGL_SWAP_UNTHROTTLED] = 0,
+        [SEGL_SWAP_VSYNC] = 1,
+        [SEGL_SWAP_HALF_RATE] = 2,
+        [SEGL_SWAP_ADAPTIVE] = 1,
+    };
+    if (!segl_ctx_swap_interval(segl_ctx, segl_vtable, intervals[mode])) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to set swap interval %d",
+            intervals[mode]
+        );
+        return false;
+    }
+    segl_ctx->swap_mode = mode;
+    return true;
+}
+
+EGLint segl_swap_adapt(
+    SEglSwapMode mode,
+    EGLint interval,
+    int64_t frame_ns,
+    int64_t refresh_ns
+) {
+    if (mode != SEGL_SWAP_ADAPTIVE || refresh_ns <= 0) {
+        return interval;
+    }
+    // NOTE: a vsynced frame takes about one refresh, so only 1.5 refreshes
+    // mean a missed vsync; the gap to 0.75 keeps the mode from flapping
+    if (interval > 0 && frame_ns > refresh_ns + refresh_ns / 2) {
+        return 0;
+    }
+    if (interval == 0 && frame_ns < refresh_ns - refresh_ns / 4) {
+        return 1;
+    }
+    return interval;
+}
+
+void segl_ctx_swap_adapt(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    int64_t frame_ns,
+    int64_t refresh_ns
+) {
+    EGLint interval = segl_swap_adapt(
+        segl_ctx->swap_mode,
+        segl_ctx->swap_interval,
+        frame_ns,
+        refresh_ns
+    );
+    if (interval != segl_ctx->swap_interval) {
+        segl_ctx_swap_interval(segl_ctx, segl_vtable, interval);
+    }
+}
+
+bool segl_recovery_register(
+    SEglRecovery *recovery,
+    SEglRecoveryFn lost,
+    SEglRecoveryFn restore,
+    void *userdata
+) {
+    if (recovery->ncallbacks == SEGL_RECOVERY_MAX_CALLBACKS) {
+        return false;
+    }
+    recovery->callbacks[recovery->ncallbacks] = (SEglRecoveryCallback){
+        .lost = lost,
+        .restore = restore,
+        .userdata = userdata,
+    };
+    recovery->ncallbacks += 1;
+    return true;
+}
+
+SEglLoss segl_loss_check(EGLBoolean result, const SEglVtable *segl_vtable) {
+    if (result) {
+        return SEGL_LOSS_NONE;
+    }
+    EGLint error = segl_vtable->GetError();
+    switch (error) {
+        case EGL_CONTEXT_LOST:
+            return SEGL_LOSS_CONTEXT;
+        case EGL_BAD_SURFACE:
+        case EGL_BAD_NATIVE_WINDOW:
+            return SEGL_LOSS_SURFACE;
+        default:
+            SEGL_LOG(
+                ANDROID_LOG_WARN,
+                "EGL call failed with 0x%x",
+                error
+            );
+            return SEGL_LOSS_NONE;
+    }
+}
+
+static void segl_recovery_notify(
+    const SEglRecovery *recovery,
+    SEglLoss loss,
+    bool restore
+) {
+    for (size_t i = 0; i < recovery->ncallbacks; i += 1) {
+        const SEglRecoveryCallback *callback = &recovery->callbacks[i];
+        SEglRecoveryFn fn = restore ? callback->restore : callback->lost;
+        if (fn != NULL) {
+            fn(loss, callback->userdata);
+        }
+    }
+}
+
+bool segl_ctx_recover(
+    SEglCtx *segl_ctx,
+    SEglRecovery *recovery,
+    SEglLoss loss,
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+) {
+    // NOTE: a retry already ran the lost callbacks, unless the loss has
+    // since grown from the surface to the context
+    SEglLoss pending = recovery->pending;
+    if (loss < pending) {
+        loss = pending;
+    }
+    if (loss == SEGL_LOSS_NONE) {
+        return true;
+    }
+    SEGL_TRACE_BEGIN("segl_ctx_recover");
+
+    TimeSpec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if (loss != pending) {
+        segl_recovery_notify(recovery, loss, false);
+    }
+    bool recovered = true;
+    if (loss == SEGL_LOSS_SURFACE) {
+        segl_ctx_surface_unload(segl_ctx, segl_vtable);
+        // NOTE: the context can still turn out lost once it is made
+        // current again, in which case the full rebuild takes over
+        SEglLoss surface_loss = segl_ctx_surface_load(
+            segl_ctx,
+            window,
+            segl_vtable
+        );
+        if (surface_loss == SEGL_LOSS_CONTEXT) {
+            loss = SEGL_LOSS_CONTEXT;
+            segl_recovery_notify(recovery, loss, false);
+        }
+        recovered = surface_loss == SEGL_LOSS_NONE;
+    }
+    if (loss == SEGL_LOSS_CONTEXT) {
+        segl_ctx_unload(segl_ctx, segl_vtable);
+        // NOTE: a failed rebuild leaves the context unloaded, keeping the
+        // swap mode for the next attempt
+        SEglSwapMode swap_mode = segl_ctx->swap_mode;
+        recovered = segl_ctx_rebuild(segl_ctx, window, segl_vtable, spec);
+        if (recovered && swap_mode != segl_ctx->swap_mode) {
+            segl_ctx_swap_mode(segl_ctx, segl_vtable, swap_mode);
+        }
+    }
+    if (!recovered) {
+        recovery->pending = loss;
+        recovery->failures += 1;
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to recover from lost %s, will retry",
+            loss == SEGL_LOSS_CONTEXT ? "context" : "surface"
+        );
+        SEGL_TRACE_END("segl_ctx_recover");
+        return false;
+    }
+    recovery->pending = SEGL_LOSS_NONE;
+    segl_recovery_notify(recovery, loss, true);
+
+    TimeSpec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    recovery->last_ns = time_since(end, start);
+    if (recovery->last_ns > recovery->max_ns) {
+        recovery->max_ns = recovery->last_ns;
+    }
+    recovery->recoveries += 1;
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "recovered from lost %s in %lld ns",
+        loss == SEGL_LOSS_CONTEXT ? "context" : "surface",
+        (long long)recovery->last_ns
+    );
+    SEGL_TRACE_END("segl_ctx_recover");
+    return true;
+}
+
+#ifndef SEGL_DIRECT_LINK
+
+static const SProcDesc sgl_proc_descs[] = {
+#define XR(type, ret, name, params, args) \
+    { "gl" #name, offsetof(SGlVtable, name), true },
+#define XV(type, name, params, args) \
+    { "gl" #name, offsetof(SGlVtable, name), true },
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+};
+
+#ifdef SGL_EAGER_LOAD
+
+static SProc sgl_egl_lookup(void *userdata, const char *name) {
+    const SEglVtable *segl_vtable = userdata;
+    return (SProc)segl_vtable->GetProcAddress(name);
+}
+
+void sgl_vtable_load(
+    SGlVtable *vtable,
+    const SEglVtable *segl_vtable,
+    SProcStats *stats
+) {
+    SEGL_TRACE_BEGIN("sgl_vtable_load");
+    uint32_t missing = sproc_table_load(
+        vtable,
+        sgl_proc_descs,
+        countof(sgl_proc_descs),
+        sgl_egl_lookup,
+        (void *)segl_vtable,
+        stats
+    );
+    if (missing > 0) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to load %u GL functions",
+            missing
+        );
+        exit(1);
+    }
+    SEGL_TRACE_END("sgl_vtable_load");
+}
+
+#else // SGL_EAGER_LOAD
+
+// Lazy mode: every slot starts out pointing at a trampoline that resolves the
+// real entry point on first call, patches the slot and forwards the call.
+// The vtable must therefore not be copied after sgl_vtable_load.
+
+enum {
+#define XR(type, ret, name, params, args) SGL_PROC_##name,
+#define XV(type, name, params, args) SGL_PROC_##name,
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+    SGL_PROC_COUNT,
+};
+
+static SGlVtable *sgl_lazy_vtable;
+static const SEglVtable *sgl_lazy_segl_vtable;
+
+// NOTE: any thread may resolve a slot while others call through it, so the
+// slot is published with an atomic store; a concurrent caller loads either
+// the trampoline or the entry point, and both forward correctly
+static SProc sgl_lazy_resolve(size_t i) {
+    // NOTE: first calls land in the middle of a frame, so each one shows
+    // up on the timeline under the name of the function it resolves
+    SEGL_TRACE_INSTANT(sgl_proc_descs[i].name);
+    SProc proc = (SProc)sgl_lazy_segl_vtable->GetProcAddress(
+        sgl_proc_descs[i].name
+    );
+    if (proc == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to load %s",
+            sgl_proc_descs[i].name
+        );
+        exit(1);
+    }
+    atomic_store_explicit(
+        (_Atomic(SProc) *)(
+            (char *)sgl_lazy_vtable + sgl_proc_descs[i].offset
+        ),
+        proc,
+        memory_order_release
+    );
+    return proc;
+}
+
+#define XR(type, ret, name, params, args) \
+    static ret GL_APIENTRY sgl_lazy_##name params { \
+        type proc = (type)sgl_lazy_resolve(SGL_PROC_##name); \
+        return proc args; \
+    }
+#define XV(type, name, params, args) \
+    static void GL_APIENTRY sgl_lazy_##name params { \
+        type proc = (type)sgl_lazy_resolve(SGL_PROC_##name); \
+        proc args; \
+    }
+SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+
+void sgl_vtable_load(
+    SGlVtable *vtable,
+    const SEglVtable *segl_vtable,
+    SProcStats *stats
+) {
+    SEGL_TRACE_BEGIN("sgl_vtable_load");
+    TimeSpec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    sgl_lazy_vtable = vtable;
+    sgl_lazy_segl_vtable = segl_vtable;
+
+#define XR(type, ret, name, params, args) vtable->name = sgl_lazy_##name;
+#define XV(type, name, params, args) vtable->name = sgl_lazy_##name;
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+
+    TimeSpec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (stats != NULL) {
+        stats->load_ns = time_since(end, start);
+        stats->loaded = 0;
+        stats->missing = 0;
+    }
+    SEGL_TRACE_END("sgl_vtable_load");
+}
+
+#endif // SGL_EAGER_LOAD
+
+#endif // SEGL_DIRECT_LINK
+
+static const char *const segl_ext_names[] = {
+#define X(id, name) name,
+    SEGL_EXTS(X)
+#undef X
+};
+
+typedef struct {
+    const char *name;
+    size_t offset;
+    uint32_t ext;
+} SEglExtProcDesc;
+
+static const SEglExtProcDesc segl_ext_proc_descs[] = {
+#define X(type, prefix, name, ext_id) \
+    { #prefix #name, offsetof(SEglExt, name), SEGL_EXT_##ext_id },
+    SEGL_EXT_PROCS(X)
+#undef X
+};
+
+// Matches each space separated token of an extension string against the
+// known extensions in a single pass.
+static uint64_t segl_ext_parse(const char *exts) {
+    uint64_t caps = 0;
+    if (exts == NULL) {
+        return caps;
+    }
+
+    const char *token = exts;
+    while (*token != '\0') {
+        while (*token == ' ') {
+            token += 1;
+        }
+        size_t len = strcspn(token, " ");
+        for (size_t i = 0; i < countof(segl_ext_names); i += 1) {
+            if (
+                strncmp(token, segl_ext_names[i], len) == 0 &&
+                segl_ext_names[i][len] == '\0'
+            ) {
+                caps |= (uint64_t)1 << i;
+            }
+        }
+        token += len;
+    }
+
+    return caps;
+}
+
+static uint32_t segl_ext_names_hash(void) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < countof(segl_ext_names); i += 1) {
+        for (const char *c = segl_ext_names[i]; *c != '\0'; c += 1) {
+            hash = (hash ^ (unsigned char)*c) * 16777619u;
+        }
+        hash = (hash ^ ' ') * 16777619u;
+    }
+    return hash;
+}
+
+static bool segl_cache_gl_matches(
+    const SEglCache *cache,
+    const SGlVtable *sgl_vtable
+) {
+    return (
+        cache->exts_hash == segl_ext_names_hash() &&
+        segl_cache_str_eq(
+            cache->gl_vendor,
+            (const char *)sgl_vtable->GetString(GL_VENDOR)
+        ) &&
+        segl_cache_str_eq(
+            cache->gl_renderer,
+            (const char *)sgl_vtable->GetString(GL_RENDERER)
+        ) &&
+        segl_cache_str_eq(
+            cache->gl_version,
+            (const char *)sgl_vtable->GetString(GL_VERSION)
+        )
+    );
+}
+
+// Requires a current context for GL_EXTENSIONS. Missing extensions never
+// fail: their capability bit stays clear and their entry points stay NULL.
+void segl_ext_load(
+    SEglExt *ext,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    EGLDisplay display,
+    const SEglCache *cache
+) {
+    SEGL_TRACE_BEGIN("segl_ext_load");
+    TimeSpec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    ext->caps_cached = cache != NULL && segl_cache_gl_matches(
+        cache,
+        sgl_vtable
+    );
+    if (ext->caps_cached) {
+        ext->caps = cache->caps;
+    } else {
+        ext->caps = segl_ext_parse(
+            segl_vtable->QueryString(display, EGL_EXTENSIONS)
+        );
+        ext->caps |= segl_ext_parse(
+            (const char *)sgl_vtable->GetString(GL_EXTENSIONS)
+        );
+    }
+
+    for (size_t i = 0; i < countof(segl_ext_proc_descs); i += 1) {
+        const SEglExtProcDesc *desc = &segl_ext_proc_descs[i];
+        uint64_t cap = (uint64_t)1 << desc->ext;
+        if ((ext->caps & cap) == 0) {
+            continue;
+        }
+
+        SProc proc = (SProc)segl_vtable->GetProcAddress(desc->name);
+        memcpy((char *)ext + desc->offset, &proc, sizeof(proc));
+        if (proc == NULL) {
+            SEGL_LOG(
+                ANDROID_LOG_WARN,
+                "%s advertised without %s",
+                segl_ext_names[desc->ext],
+                desc->name
+            );
+            ext->caps &= ~cap;
+        }
+    }
+
+    // NOTE: clear entry points of extensions disabled by a missing function
+    for (size_t i = 0; i < countof(segl_ext_proc_descs); i += 1) {
+        const SEglExtProcDesc *desc = &segl_ext_proc_descs[i];
+        if ((ext->caps & ((uint64_t)1 << desc->ext)) == 0) {
+            SProc proc = NULL;
+            memcpy((char *)ext + desc->offset, &proc, sizeof(proc));
+        }
+    }
+    ext->loaded = true;
+
+    TimeSpec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "extension caps 0x%llx%s in %lld ns",
+        (unsigned long long)ext->caps,
+        ext->caps_cached ? " (cached)" : "",
+        (long long)time_since(end, start)
+    );
+    SEGL_TRACE_END("segl_ext_load");
+}
+
+SEglCtx segl_ctx_headless_load(
+    SEglHeadlessMode mode,
+    EGLint width,
+    EGLint height,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec,
+    SEglHeadlessMode *mode_used
+) {
+    SEglCtx segl_ctx;
+    segl_ctx.display = segl_display_load(segl_vtable);
+    if (segl_ctx.display == EGL_NO_DISPLAY) {
+        exit(1);
+    }
+
+    uint64_t caps = segl_ext_parse(
+        segl_vtable->QueryString(segl_ctx.display, EGL_EXTENSIONS)
+    );
+    if (
+        mode == SEGL_HEADLESS_SURFACELESS &&
+        (caps & SEGL_CAP(EGL_KHR_SURFACELESS_CONTEXT)) == 0
+    ) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "EGL_KHR_surfaceless_context missing, using a pbuffer"
+        );
+        mode = SEGL_HEADLESS_PBUFFER;
+    }
+
+    SEglConfigSpec headless_spec = *spec;
+    headless_spec.surface_type = (
+        mode == SEGL_HEADLESS_PBUFFER ? EGL_PBUFFER_BIT : 0
+    );
+    if (!segl_ctx_context_load(&segl_ctx, segl_vtable, &headless_spec)) {
+        exit(1);
+    }
+
+    if (mode == SEGL_HEADLESS_PBUFFER) {
+        const EGLint pbuffer_attribs[] = {
+            EGL_WIDTH,
+            width,
+            EGL_HEIGHT,
+            height,
+            EGL_NONE,
+        };
+        segl_ctx.surface = segl_vtable->CreatePbufferSurface(
+            segl_ctx.display,
+            segl_ctx.config,
+            pbuffer_attribs
+        );
+        if (segl_ctx.surface == EGL_NO_SURFACE) {
+            SEGL_LOG(
+                ANDROID_LOG_ERROR,
+                "failed to create %dx%d pbuffer",
+                width,
+                height
+            );
+            exit(1);
+        }
+    }
+
+    if (
+        !segl_vtable->MakeCurrent(
+            segl_ctx.display,
+            segl_ctx.surface,
+            segl_ctx.surface,
+            segl_ctx.context
+        )
+    ) {
+        SEGL_LOG(
+            ANDROID_LOG_ERROR,
+            "failed to make headless context current"
+        );
+        exit(1);
+    }
+
+    if (mode_used != NULL) {
+        *mode_used = mode;
+    }
+    return segl_ctx;
+}
+
+// FNV-1a over the whole struct with the checksum field zeroed. Padding is
+// covered too, which is why segl_cache_fill clears the struct first.
+static uint32_t segl_cache_checksum(const SEglCache *cache) {
+    SEglCache copy = *cache;
+    copy.checksum = 0;
+
+    uint32_t hash = 2166136261u;
+    const unsigned char *bytes = (const unsigned char *)&copy;
+    for (size_t i = 0; i < sizeof(copy); i += 1) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool segl_cache_read(SEglCache *cache, const char *path) {
+    memset(cache, 0, sizeof(*cache));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    size_t read = fread(cache, 1, sizeof(*cache), file);
+    fclose(file);
+
+    bool valid = (
+        read == sizeof(*cache) &&
+        cache->magic == SEGL_CACHE_MAGIC &&
+        cache->version == SEGL_CACHE_VERSION &&
+        cache->size == sizeof(*cache) &&
+        cache->checksum == segl_cache_checksum(cache) &&
+        (unsigned)cache->policy <= SEGL_CONFIG_EXACT &&
+        cache->egl_vendor[SEGL_CACHE_STR_LEN - 1] == '\0' &&
+        cache->egl_version[SEGL_CACHE_STR_LEN - 1] == '\0' &&
+        cache->gl_vendor[SEGL_CACHE_STR_LEN - 1] == '\0' &&
+        cache->gl_renderer[SEGL_CACHE_STR_LEN - 1] == '\0' &&
+        cache->gl_version[SEGL_CACHE_STR_LEN - 1] == '\0'
+    );
+    if (!valid) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "ignoring invalid EGL cache %s",
+            path
+        );
+        memset(cache, 0, sizeof(*cache));
+    }
+    return valid;
+}
+
+bool segl_cache_write(const SEglCache *cache, const char *path) {
+    SEglCache copy = *cache;
+    copy.magic = SEGL_CACHE_MAGIC;
+    copy.version = SEGL_CACHE_VERSION;
+    copy.size = sizeof(copy);
+    copy.checksum = segl_cache_checksum(&copy);
+
+    char tmp_path[4096];
+    int len = snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    if (len < 0 || (size_t)len >= sizeof(tmp_path)) {
+        return false;
+    }
+
+    FILE *file = fopen(tmp_path, "wb");
+    if (file == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to open EGL cache %s",
+            tmp_path
+        );
+        return false;
+    }
+    bool written = fwrite(&copy, sizeof(copy), 1, file) == 1;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tmp_path, path) != 0) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to write EGL cache %s",
+            path
+        );
+        remove(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+void segl_cache_fill(
+    SEglCache *cache,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    const SEglCtx *segl_ctx,
+    const SEglConfigSpec *spec,
+    const SEglExt *ext
+) {
+    memset(cache, 0, sizeof(*cache));
+
+    cache->policy = spec->policy;
+    cache->surface_type = spec->surface_type;
+    cache->exact = spec->exact;
+    segl_cache_str_copy(
+        cache->egl_vendor,
+        segl_vtable->QueryString(segl_ctx->display, EGL_VENDOR)
+    );
+    segl_cache_str_copy(
+        cache->egl_version,
+        segl_vtable->QueryString(segl_ctx->display, EGL_VERSION)
+    );
+    cache->attribs = segl_ctx->attribs;
+
+    segl_cache_str_copy(
+        cache->gl_vendor,
+        (const char *)sgl_vtable->GetString(GL_VENDOR)
+    );
+    segl_cache_str_copy(
+        cache->gl_renderer,
+        (const char *)sgl_vtable->GetString(GL_RENDERER)
+    );
+    segl_cache_str_copy(
+        cache->gl_version,
+        (const char *)sgl_vtable->GetString(GL_VERSION)
+    );
+    cache->exts_hash = segl_ext_names_hash();
+    cache->caps = ext->caps;
+}
@@ -0,0 +1,394 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_H
+#define SEGL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include "segl_procs.h"
+
+#define SEGL_ANDROID_LOG_ID "SEGLAPP"
+
+#ifndef SEGL_LIBEGL_NAME
+#define SEGL_LIBEGL_NAME "libEGL.so"
+#endif
+
+#define countof(x) (sizeof(x) / (sizeof((x)[0])))
+
+typedef struct timespec TimeSpec;
+
+typedef void (*SProc)(void);
+
+typedef struct {
+    int64_t load_ns;
+    uint32_t loaded;
+    uint32_t missing;
+} SProcStats;
+
+static inline int64_t time_since(TimeSpec end, TimeSpec start) {
+    int64_t seconds = (int64_t)end.tv_sec - (int64_t)start.tv_sec;
+    int64_t sec_diff = seconds * 1000L * 1000L * 1000L;
+    int64_t nsec_diff = (int64_t)end.tv_nsec - (int64_t)start.tv_nsec;
+    return sec_diff + nsec_diff;
+}
+
+typedef struct {
+#define X(type, name, required) type name;
+    SEGL_EGL_PROCS(X)
+#undef X
+} SEglVtable;
+
+typedef struct {
+#define XR(type, ret, name, params, args) type name;
+#define XV(type, name, params, args) type name;
+    SGL_GL_PROCS(XR, XV)
+#undef XV
+#undef XR
+} SGlVtable;
+
+enum {
+#define X(id, name) SEGL_EXT_##id,
+    SEGL_EXTS(X)
+#undef X
+    SEGL_EXT_COUNT,
+};
+
+_Static_assert(SEGL_EXT_COUNT <= 64, "capability bitmap is 64 bits");
+
+#define SEGL_CAP(id) ((uint64_t)1 << SEGL_EXT_##id)
+
+typedef struct {
+    uint64_t caps;
+    bool loaded;
+    // the caps came from SEglCache instead of the extension strings
+    bool caps_cached;
+#define X(type, prefix, name, ext_id) type name;
+    SEGL_EXT_PROCS(X)
+#undef X
+} SEglExt;
+
+typedef enum {
+    // no MSAA, no depth/stencil and the fewest color bits, e.g. RGB565
+    SEGL_CONFIG_PERFORMANCE,
+    // the most MSAA samples, then the most color and depth/stencil bits
+    SEGL_CONFIG_QUALITY,
+    // the config closest to SEglConfigSpec.exact
+    SEGL_CONFIG_EXACT,
+} SEglConfigPolicy;
+
+typedef struct {
+    EGLint config_id;
+    EGLint red;
+    EGLint green;
+    EGLint blue;
+    EGLint alpha;
+    EGLint depth;
+    EGLint stencil;
+    EGLint samples;
+    EGLint surface_type;
+    EGLint renderable_type;
+    EGLint color_buffer_type;
+    EGLint caveat;
+} SEglConfigAttribs;
+
+typedef struct {
+    SEglConfigPolicy policy;
+    // surface type bits that every candidate must support
+    EGLint surface_type;
+    // sizes for SEGL_CONFIG_EXACT, EGL_DONT_CARE to ignore a size
+    SEglConfigAttribs exact;
+    // optional result of an earlier run, see SEglCache
+    const struct SEglCache *cache;
+} SEglConfigSpec;
+
+#define SEGL_CONFIG_REJECT INT64_MIN
+
+#define SEGL_CACHE_MAGIC 0x43474553u // "SEGC"
+#define SEGL_CACHE_VERSION 1u
+#define SEGL_CACHE_STR_LEN 128
+
+// Startup results persisted between runs. The config is reused only while
+// the spec and the EGL vendor/version match, the caps only while the GL
+// vendor/renderer/version match; anything else falls back to a full query.
+typedef struct SEglCache {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t checksum;
+
+    SEglConfigPolicy policy;
+    EGLint surface_type;
+    SEglConfigAttribs exact;
+    char egl_vendor[SEGL_CACHE_STR_LEN];
+    char egl_version[SEGL_CACHE_STR_LEN];
+    SEglConfigAttribs attribs;
+
+    char gl_vendor[SEGL_CACHE_STR_LEN];
+    char gl_renderer[SEGL_CACHE_STR_LEN];
+    char gl_version[SEGL_CACHE_STR_LEN];
+    // hash of SEGL_EXTS, since the caps bits follow its order
+    uint32_t exts_hash;
+    uint64_t caps;
+} SEglCache;
+
+typedef enum {
+    // swap as soon as a buffer is free; tears, but shows raw throughput
+    SEGL_SWAP_UNTHROTTLED,
+    // one swap per display refresh
+    SEGL_SWAP_VSYNC,
+    // one swap every second refresh, e.g. 30 fps on a 60 Hz display
+    SEGL_SWAP_HALF_RATE,
+    // vsync while frames fit the refresh period, unthrottled while they do
+    // not, so a slow frame tears instead of waiting a whole extra refresh
+    SEGL_SWAP_ADAPTIVE,
+} SEglSwapMode;
+
+typedef enum {
+    SEGL_LOSS_NONE,
+    // the surface is gone but the context and its objects survive
+    SEGL_LOSS_SURFACE,
+    // the context and every GL object in it are gone
+    SEGL_LOSS_CONTEXT,
+} SEglLoss;
+
+// Surface pixels with a bottom-left origin, as used by glScissor and the
+// EGL damage extensions.
+typedef struct {
+    EGLint x;
+    EGLint y;
+    EGLint width;
+    EGLint height;
+} SEglRect;
+
+typedef struct {
+    EGLDisplay display;
+    EGLConfig config;
+    SEglConfigAttribs attribs;
+    EGLContext context;
+    EGLSurface surface;
+    // the config came from SEglConfigSpec.cache
+    bool config_cached;
+    SEglSwapMode swap_mode;
+    // interval last passed to eglSwapInterval, reapplied to new surfaces
+    EGLint swap_interval;
+} SEglCtx;
+
+// Initializers for direct-link vtables, e.g.
+//     static const SEglVtable egl = { SEGL_EGL_PROCS(SEGL_DIRECT_X) };
+#define SEGL_DIRECT_X(type, name, required) .name = egl##name,
+#define SGL_DIRECT_XR(type, ret, name, params, args) .name = gl##name,
+#define SGL_DIRECT_XV(type, name, params, args) .name = gl##name,
+
+// Calls through a vtable passed by pointer, e.g.
+//     SGL_CALL(sgl_vtable, Clear)(GL_COLOR_BUFFER_BIT);
+// With SEGL_DIRECT_LINK they name the export instead, so per-frame calls
+// made outside the app's translation unit are direct calls too.
+#ifdef SEGL_DIRECT_LINK
+#define SEGL_CALL(vtable, name) egl##name
+#define SGL_CALL(vtable, name) gl##name
+#else // SEGL_DIRECT_LINK
+#define SEGL_CALL(vtable, name) (vtable)->name
+#define SGL_CALL(vtable, name) (vtable)->name
+#endif // SEGL_DIRECT_LINK
+
+#ifndef SEGL_DIRECT_LINK
+// Loads libEGL from path, or SEGL_LIBEGL_NAME when path is NULL.
+SEglVtable segl_vtable_load(const char *path, SProcStats *stats);
+void sgl_vtable_load(
+    SGlVtable *vtable,
+    const SEglVtable *segl_vtable,
+    SProcStats *stats
+);
+#endif // SEGL_DIRECT_LINK
+
+// Scores a config under the spec's policy, higher is better. Configs that
+// cannot be used at all score SEGL_CONFIG_REJECT.
+int64_t segl_config_score(
+    const SEglConfigAttribs *config,
+    const SEglConfigSpec *spec
+);
+// Returns the index of the best scoring config, or -1 if all are rejected.
+// Ties keep the driver's order.
+int segl_config_select(
+    const SEglConfigAttribs *configs,
+    int nconfigs,
+    const SEglConfigSpec *spec
+);
+// Returns the config in spec->cache, which must be set, when the cache was
+// made for the same spec and EGL driver and the driver still has the
+// config; otherwise NULL. Sets chosen to the cached attributes on a hit.
+EGLConfig segl_config_from_cache(
+    const SEglVtable *segl_vtable,
+    EGLDisplay display,
+    const SEglConfigSpec *spec,
+    SEglConfigAttribs *chosen
+);
+
+// Creates the display, context and window surface and makes them current.
+// Failures are fatal, so after a loss rebuild through segl_ctx_recover.
+SEglCtx segl_ctx_load(
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+);
+
+typedef enum {
+    // a width x height pbuffer stands in for the window surface
+    SEGL_HEADLESS_PBUFFER,
+    // no surface at all through EGL_KHR_surfaceless_context, so there is
+    // no default framebuffer and frames must go to a framebuffer object;
+    // falls back to a pbuffer when the extension is missing
+    SEGL_HEADLESS_SURFACELESS,
+} SEglHeadlessMode;
+
+// Creates a current context without a native window, e.g. to run the
+// render path in CI. The spec's surface type is replaced by what the mode
+// needs. On Mesa, EGL_PLATFORM=surfaceless gives a display without X11 or
+// Wayland. Returns the mode actually used in mode_used when non-NULL.
+SEglCtx segl_ctx_headless_load(
+    SEglHeadlessMode mode,
+    EGLint width,
+    EGLint height,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec,
+    SEglHeadlessMode *mode_used
+);
+void segl_ctx_unload(SEglCtx *segl_ctx, const SEglVtable *segl_vtable);
+
+// Creates a window surface for a loaded context and makes both current.
+// Returns SEGL_LOSS_CONTEXT when the context turned out to be lost and
+// SEGL_LOSS_SURFACE when the surface could not be created or made current,
+// leaving no surface either way; see segl_ctx_recover.
+SEglLoss segl_ctx_surface_load(
+    SEglCtx *segl_ctx,
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable
+);
+// Releases and destroys only the surface; the display, config and context
+// stay valid for a later segl_ctx_surface_load.
+void segl_ctx_surface_unload(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable
+);
+
+// Sets the swap mode of the current surface, clamping the interval to the
+// config's EGL_MIN/MAX_SWAP_INTERVAL. Returns false if the driver refused.
+bool segl_ctx_swap_mode(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    SEglSwapMode mode
+);
+// Returns the interval SEGL_SWAP_ADAPTIVE should use for the next frame
+// given how long the last one took; other modes keep their interval.
+EGLint segl_swap_adapt(
+    SEglSwapMode mode,
+    EGLint interval,
+    int64_t frame_ns,
+    int64_t refresh_ns
+);
+// Applies segl_swap_adapt to the context, calling eglSwapInterval only
+// when the interval changes.
+void segl_ctx_swap_adapt(
+    SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    int64_t frame_ns,
+    int64_t refresh_ns
+);
+
+#define SEGL_RECOVERY_MAX_CALLBACKS 16
+
+// Called with the loss before teardown, while the old context is still
+// current, and again after the rebuild with the new context current.
+typedef void (*SEglRecoveryFn)(SEglLoss loss, void *userdata);
+
+typedef struct {
+    SEglRecoveryFn lost;
+    SEglRecoveryFn restore;
+    void *userdata;
+} SEglRecoveryCallback;
+
+typedef struct {
+    SEglRecoveryCallback callbacks[SEGL_RECOVERY_MAX_CALLBACKS];
+    size_t ncallbacks;
+    uint32_t recoveries;
+    // rebuilds that failed and are to be retried
+    uint32_t failures;
+    // the loss of the last failed rebuild, SEGL_LOSS_NONE after a success
+    SEglLoss pending;
+    int64_t last_ns;
+    int64_t max_ns;
+} SEglRecovery;
+
+// Either callback may be NULL. Returns false when the table is full.
+bool segl_recovery_register(
+    SEglRecovery *recovery,
+    SEglRecoveryFn lost,
+    SEglRecoveryFn restore,
+    void *userdata
+);
+// Classifies the result of eglSwapBuffers or eglMakeCurrent, reading
+// eglGetError only when result is EGL_FALSE.
+SEglLoss segl_loss_check(EGLBoolean result, const SEglVtable *segl_vtable);
+// Rebuilds what the loss took: the window surface, or the whole context
+// as segl_ctx_load would, keeping the swap mode. Runs the lost callbacks
+// before and the restore callbacks after, and reports the time taken.
+// Returns false instead of exiting when the rebuild fails, leaving no
+// surface (or no context) and the loss in recovery->pending; a later call,
+// with SEGL_LOSS_NONE or a new loss, retries it.
+bool segl_ctx_recover(
+    SEglCtx *segl_ctx,
+    SEglRecovery *recovery,
+    SEglLoss loss,
+    EGLNativeWindowType window,
+    const SEglVtable *segl_vtable,
+    const SEglConfigSpec *spec
+);
+
+// Parses the extension strings, or takes the caps from cache when it is
+// non-NULL and matches the current GL driver.
+void segl_ext_load(
+    SEglExt *ext,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    EGLDisplay display,
+    const SEglCache *cache
+);
+
+// Reads and validates a cache file. Returns false on a missing, truncated,
+// corrupt or older-version file, leaving the cache zeroed.
+bool segl_cache_read(SEglCache *cache, const char *path);
+// Writes through a temporary file and a rename, so a crash never leaves a
+// half written cache behind.
+bool segl_cache_write(const SEglCache *cache, const char *path);
+// Records the current spec, config, driver identity and caps.
+void segl_cache_fill(
+    SEglCache *cache,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    const SEglCtx *segl_ctx,
+    const SEglConfigSpec *spec,
+    const SEglExt *ext
+);
+
+#endif // SEGL_H
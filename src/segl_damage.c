@@ -0,0 +1,250 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl.h"
+#include "segl_damage.h"
+
+static SEglRect segl_rect_clip(SEglRect rect, EGLint width, EGLint height) {
+    EGLint x0 = rect.x < 0 ? 0 : rect.x;
+    EGLint y0 = rect.y < 0 ? 0 : rect.y;
+    EGLint x1 = rect.x + rect.width > width ? width : rect.x + rect.width;
+    EGLint y1 = rect.y + rect.height > height ? height : rect.y + rect.height;
+    return (SEglRect){
+        .x = x0,
+        .y = y0,
+        .width = x1 > x0 ? x1 - x0 : 0,
+        .height = y1 > y0 ? y1 - y0 : 0,
+    };
+}
+
+static bool segl_rect_contains(SEglRect outer, SEglRect inner) {
+    return (
+        inner.x >= outer.x &&
+        inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height
+    );
+}
+
+static SEglRect segl_rect_union(SEglRect a, SEglRect b) {
+    EGLint x0 = a.x < b.x ? a.x : b.x;
+    EGLint y0 = a.y < b.y ? a.y : b.y;
+    EGLint x1 = a.x + a.width > b.x + b.width ? a.x + a.width : b.x + b.width;
+    EGLint y1 = (
+        a.y + a.height > b.y + b.height ? a.y + a.height : b.y + b.height
+    );
+    return (SEglRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+void segl_damage_region_add(SEglDamageRegion *region, SEglRect rect) {
+    if (region->full || rect.width <= 0 || rect.height <= 0) {
+        return;
+    }
+    for (int i = 0; i < region->nrects; i += 1) {
+        if (segl_rect_contains(region->rects[i], rect)) {
+            return;
+        }
+    }
+    if (region->nrects < SEGL_DAMAGE_MAX_RECTS) {
+        region->rects[region->nrects] = rect;
+        region->nrects += 1;
+        return;
+    }
+
+    SEglRect bounds = rect;
+    for (int i = 0; i < region->nrects; i += 1) {
+        bounds = segl_rect_union(bounds, region->rects[i]);
+    }
+    region->rects[0] = bounds;
+    region->nrects = 1;
+}
+
+static void segl_damage_region_merge(
+    SEglDamageRegion *region,
+    const SEglDamageRegion *other
+) {
+    if (other->full) {
+        region->full = true;
+        return;
+    }
+    for (int i = 0; i < other->nrects; i += 1) {
+        segl_damage_region_add(region, other->rects[i]);
+    }
+}
+
+int64_t segl_damage_region_area(
+    const SEglDamageRegion *region,
+    EGLint width,
+    EGLint height
+) {
+    if (region->full) {
+        return (int64_t)width * height;
+    }
+    int64_t area = 0;
+    for (int i = 0; i < region->nrects; i += 1) {
+        area += (int64_t)region->rects[i].width * region->rects[i].height;
+    }
+    return area;
+}
+
+// Flattens the region into x, y, width, height quadruples for EGL.
+static EGLint segl_damage_region_flatten(
+    const SEglDamageRegion *region,
+    EGLint *rects
+) {
+    for (int i = 0; i < region->nrects; i += 1) {
+        rects[i * 4 + 0] = region->rects[i].x;
+        rects[i * 4 + 1] = region->rects[i].y;
+        rects[i * 4 + 2] = region->rects[i].width;
+        rects[i * 4 + 3] = region->rects[i].height;
+    }
+    return region->nrects;
+}
+
+void segl_damage_add(SEglDamage *damage, SEglRect rect) {
+    segl_damage_region_add(&damage->frame, rect);
+}
+
+void segl_damage_invalidate(SEglDamage *damage) {
+    damage->frame.full = true;
+}
+
+void segl_damage_resize(SEglDamage *damage, EGLint width, EGLint height) {
+    if (width == damage->width && height == damage->height) {
+        return;
+    }
+    damage->width = width;
+    damage->height = height;
+    damage->frame.full = true;
+    for (int i = 0; i < SEGL_DAMAGE_HISTORY; i += 1) {
+        damage->history[i] = (SEglDamageRegion){ .full = true };
+    }
+}
+
+const SEglDamageRegion *segl_damage_begin(
+    SEglDamage *damage,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+) {
+    EGLint width = damage->width;
+    EGLint height = damage->height;
+
+    // NOTE: EGL_BUFFER_AGE_KHR from partial update has the same value
+    damage->age = 0;
+    if (
+        (ext->caps & SEGL_CAP(EGL_EXT_BUFFER_AGE)) != 0 ||
+        (ext->caps & SEGL_CAP(EGL_KHR_PARTIAL_UPDATE)) != 0
+    ) {
+        SEGL_CALL(segl_vtable, QuerySurface)(
+            segl_ctx->display,
+            segl_ctx->surface,
+            EGL_BUFFER_AGE_EXT,
+            &damage->age
+        );
+    }
+
+    // NOTE: a buffer of age n holds the frame from n swaps ago, so it
+    // misses this frame's damage and that of the n - 1 frames in between
+    damage->redraw = (SEglDamageRegion){ .full = true };
+    if (damage->age > 0 && damage->age <= SEGL_DAMAGE_HISTORY + 1) {
+        damage->redraw = (SEglDamageRegion){ .full = false };
+        for (int i = 0; i < damage->frame.nrects; i += 1) {
+            segl_damage_region_add(
+                &damage->redraw,
+                segl_rect_clip(damage->frame.rects[i], width, height)
+            );
+        }
+        damage->redraw.full = damage->frame.full;
+        for (EGLint i = 0; i < damage->age - 1; i += 1) {
+            segl_damage_region_merge(&damage->redraw, &damage->history[i]);
+        }
+    }
+
+    if (
+        (ext->caps & SEGL_CAP(EGL_KHR_PARTIAL_UPDATE)) != 0 &&
+        !damage->redraw.full &&
+        damage->redraw.nrects > 0
+    ) {
+        EGLint rects[SEGL_DAMAGE_MAX_RECTS * 4];
+        EGLint nrects = segl_damage_region_flatten(&damage->redraw, rects);
+        ext->SetDamageRegionKHR(
+            segl_ctx->display,
+            segl_ctx->surface,
+            rects,
+            nrects
+        );
+    }
+
+    damage->frames += 1;
+    damage->pixels_redrawn += (uint64_t)segl_damage_region_area(
+        &damage->redraw,
+        width,
+        height
+    );
+    damage->pixels_total += (uint64_t)width * (uint64_t)height;
+    return &damage->redraw;
+}
+
+EGLBoolean segl_damage_swap(
+    SEglDamage *damage,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+) {
+    SEglDamageRegion frame = { .full = damage->frame.full };
+    for (int i = 0; i < damage->frame.nrects; i += 1) {
+        segl_damage_region_add(
+            &frame,
+            segl_rect_clip(
+                damage->frame.rects[i],
+                damage->width,
+                damage->height
+            )
+        );
+    }
+
+    // NOTE: zero rects would mean the whole surface, which is also the
+    // right answer for a frame that reported no damage at all
+    EGLBoolean swapped;
+    if ((ext->caps & SEGL_CAP(EGL_KHR_SWAP_BUFFERS_WITH_DAMAGE)) != 0) {
+        EGLint rects[SEGL_DAMAGE_MAX_RECTS * 4];
+        EGLint nrects = frame.full ? 0 : segl_damage_region_flatten(
+            &frame,
+            rects
+        );
+        swapped = ext->SwapBuffersWithDamageKHR(
+            segl_ctx->display,
+            segl_ctx->surface,
+            rects,
+            nrects
+        );
+    } else {
+        swapped = SEGL_CALL(segl_vtable, SwapBuffers)(
+            segl_ctx->display,
+            segl_ctx->surface
+        );
+    }
+
+    for (int i = SEGL_DAMAGE_HISTORY - 1; i > 0; i -= 1) {
+        damage->history[i] = damage->history[i - 1];
+    }
+    damage->history[0] = frame;
+    damage->frame = (SEglDamageRegion){ .full = false };
+    return swapped;
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_DAMAGE_H
+#define SEGL_DAMAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl.h"
+
+// Rects kept per region before it collapses into its bounding box.
+#define SEGL_DAMAGE_MAX_RECTS 8
+// Frames of damage remembered, enough for a buffer age of
+// SEGL_DAMAGE_HISTORY + 1; older buffers are redrawn in full.
+#define SEGL_DAMAGE_HISTORY 3
+
+typedef struct {
+    // the whole surface, rects are unused
+    bool full;
+    int nrects;
+    SEglRect rects[SEGL_DAMAGE_MAX_RECTS];
+} SEglDamageRegion;
+
+// Per-surface damage tracking. Each frame:
+//     segl_damage_add(...) for everything that changed since the last frame
+//     region = segl_damage_begin(...), then redraw only region's rects
+//     segl_damage_swap(...)
+// Without EGL_EXT_buffer_age (or EGL_KHR_partial_update) the back buffer
+// contents are undefined, so every frame is a full redraw; the frame's
+// damage still reaches the compositor through swap with damage.
+typedef struct {
+    EGLint width;
+    EGLint height;
+    EGLint age;
+    // changed since the last frame
+    SEglDamageRegion frame;
+    // damage of earlier frames, [0] is the last frame
+    SEglDamageRegion history[SEGL_DAMAGE_HISTORY];
+    // what segl_damage_begin asked to be redrawn
+    SEglDamageRegion redraw;
+    uint64_t frames;
+    uint64_t pixels_redrawn;
+    uint64_t pixels_total;
+} SEglDamage;
+
+// Marks a rect as changed, clipped to the surface later.
+void segl_damage_add(SEglDamage *damage, SEglRect rect);
+// Marks the whole surface as changed, e.g. after content was lost.
+void segl_damage_invalidate(SEglDamage *damage);
+// Sets the surface size, e.g. from an SEglSurfaceState resize callback;
+// a new size drops the history and redraws in full.
+void segl_damage_resize(SEglDamage *damage, EGLint width, EGLint height);
+// Merges rect into region, collapsing to the bounding box when the region
+// runs out of rects.
+void segl_damage_region_add(SEglDamageRegion *region, SEglRect rect);
+// Area of the region, counting overlaps twice, so an upper bound.
+int64_t segl_damage_region_area(
+    const SEglDamageRegion *region,
+    EGLint width,
+    EGLint height
+);
+
+// Queries the buffer age and returns the region that
+// must be redrawn before the next swap. With EGL_KHR_partial_update the
+// region is also passed to eglSetDamageRegionKHR, so this must come before
+// any rendering to the surface.
+const SEglDamageRegion *segl_damage_begin(
+    SEglDamage *damage,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+);
+// Swaps with the frame's damage when EGL_KHR_swap_buffers_with_damage is
+// available, else with eglSwapBuffers, and moves the damage into history.
+EGLBoolean segl_damage_swap(
+    SEglDamage *damage,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+);
+
+#endif // SEGL_DAMAGE_H
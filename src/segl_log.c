@@ -0,0 +1,342 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "segl_log.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/prctl.h>
+
+#include <android/log.h>
+
+#include "segl.h"
+
+_Static_assert(
+    (SEGL_LOG_RING_LEN & (SEGL_LOG_RING_LEN - 1)) == 0,
+    "SEGL_LOG_RING_LEN must be a power of two"
+);
+
+#define SEGL_LOG_FLUSH_NS 100000000LL
+#define SEGL_LOG_FLUSH_POLL_NS 1000000L
+// how long the drain thread lets messages gather after a wake
+#define SEGL_LOG_BATCH_NS 4000000L
+
+// The slot for position pos is free for a producer while seq == pos and
+// holds a message for the drain thread once seq == pos + 1; the drain
+// thread frees it for the next lap with seq = pos + SEGL_LOG_RING_LEN.
+typedef struct {
+    atomic_size_t seq;
+    int prio;
+    const char *tag;
+    char text[SEGL_LOG_MSG_LEN];
+} SEglLogSlot;
+
+static SEglLogSlot segl_log_ring[SEGL_LOG_RING_LEN];
+// next position claimed by a producer
+static atomic_size_t segl_log_head;
+// next position written by the drain thread
+static atomic_size_t segl_log_tail;
+static atomic_bool segl_log_running;
+// set by the drain thread before it waits, so that producers only post
+// (a futex wake) when it is asleep
+static atomic_bool segl_log_sleeping;
+static _Atomic uint64_t segl_log_dropped_count;
+static sem_t segl_log_wake;
+
+static int64_t segl_log_now(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000L + now.tv_nsec;
+}
+
+// NOTE: on the host android/log.h is a stand-in that writes to stderr
+static void segl_log_write(int prio, const char *tag, const char *text) {
+    __android_log_write(prio, tag, text);
+}
+
+static void segl_log_format(
+    char *text,
+    unsigned suppressed,
+    const char *fmt,
+    va_list args
+) {
+    int len = vsnprintf(text, SEGL_LOG_MSG_LEN, fmt, args);
+    if (suppressed > 0 && len >= 0 && len < SEGL_LOG_MSG_LEN) {
+        snprintf(
+            text + len,
+            SEGL_LOG_MSG_LEN - (size_t)len,
+            " (%u suppressed)",
+            suppressed
+        );
+    }
+}
+
+// Returns false if the site is over its burst for the current window;
+// otherwise sets suppressed to the messages it dropped since the last one
+// admitted.
+static bool segl_log_admit(SEglLogSite *site, unsigned *suppressed) {
+    *suppressed = 0;
+    if (site == NULL) {
+        return true;
+    }
+    int64_t now_ns = segl_log_now();
+    int64_t start_ns = atomic_load_explicit(
+        &site->window_start_ns,
+        memory_order_relaxed
+    );
+    if (
+        now_ns - start_ns >= SEGL_LOG_WINDOW_NS &&
+        atomic_compare_exchange_strong_explicit(
+            &site->window_start_ns,
+            &start_ns,
+            now_ns,
+            memory_order_relaxed,
+            memory_order_relaxed
+        )
+    ) {
+        atomic_store_explicit(&site->count, 0, memory_order_relaxed);
+    }
+    unsigned count = atomic_fetch_add_explicit(
+        &site->count,
+        1,
+        memory_order_relaxed
+    );
+    if (count >= SEGL_LOG_BURST) {
+        atomic_fetch_add_explicit(&site->suppressed, 1, memory_order_relaxed);
+        return false;
+    }
+    *suppressed = atomic_exchange_explicit(
+        &site->suppressed,
+        0,
+        memory_order_relaxed
+    );
+    return true;
+}
+
+// Claims the next free slot, formats into it and wakes the drain thread.
+// Returns false when the ring is full.
+static bool segl_log_push(
+    int prio,
+    const char *tag,
+    unsigned suppressed,
+    const char *fmt,
+    va_list args
+) {
+    size_t pos = atomic_load_explicit(&segl_log_head, memory_order_relaxed);
+    SEglLogSlot *slot;
+    for (;;) {
+        slot = &segl_log_ring[pos & (SEGL_LOG_RING_LEN - 1)];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        ptrdiff_t lag = (ptrdiff_t)(seq - pos);
+        if (lag == 0) {
+            if (
+                atomic_compare_exchange_weak_explicit(
+                    &segl_log_head,
+                    &pos,
+                    pos + 1,
+                    memory_order_relaxed,
+                    memory_order_relaxed
+                )
+            ) {
+                break;
+            }
+        } else if (lag < 0) {
+            // still holds the message from a lap ago
+            return false;
+        } else {
+            pos = atomic_load_explicit(&segl_log_head, memory_order_relaxed);
+        }
+    }
+
+    slot->prio = prio;
+    slot->tag = tag;
+    segl_log_format(slot->text, suppressed, fmt, args);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    // NOTE: pairs with the fence in segl_log_thread; either this sees it
+    // sleeping or it sees this message
+    atomic_thread_fence(memory_order_seq_cst);
+    if (
+        atomic_load_explicit(&segl_log_sleeping, memory_order_relaxed) &&
+        atomic_exchange_explicit(
+            &segl_log_sleeping,
+            false,
+            memory_order_relaxed
+        )
+    ) {
+        sem_post(&segl_log_wake);
+    }
+    return true;
+}
+
+static bool segl_log_ready(size_t pos) {
+    const SEglLogSlot *slot = &segl_log_ring[pos & (SEGL_LOG_RING_LEN - 1)];
+    return atomic_load_explicit(&slot->seq, memory_order_acquire) == pos + 1;
+}
+
+// Writes messages until the ring is empty or the next slot is still being
+// formatted.
+static void segl_log_drain(void) {
+    size_t pos = atomic_load_explicit(&segl_log_tail, memory_order_relaxed);
+    while (segl_log_ready(pos)) {
+        SEglLogSlot *slot = &segl_log_ring[pos & (SEGL_LOG_RING_LEN - 1)];
+        segl_log_write(slot->prio, slot->tag, slot->text);
+        atomic_store_explicit(
+            &slot->seq,
+            pos + SEGL_LOG_RING_LEN,
+            memory_order_release
+        );
+        pos += 1;
+        atomic_store_explicit(&segl_log_tail, pos, memory_order_release);
+    }
+}
+
+static void *segl_log_thread(void *userdata) {
+    prctl(PR_SET_NAME, "segl_log", 0, 0, 0);
+    uint64_t reported = 0;
+    for (;;) {
+        atomic_store_explicit(&segl_log_sleeping, true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        size_t tail = atomic_load_explicit(
+            &segl_log_tail,
+            memory_order_relaxed
+        );
+        if (segl_log_ready(tail)) {
+            // a producer that saw the flag posts anyway, costing one loop
+            atomic_store_explicit(
+                &segl_log_sleeping,
+                false,
+                memory_order_relaxed
+            );
+        } else {
+            sem_wait(&segl_log_wake);
+        }
+        // NOTE: the flag stays clear meanwhile, so the rest of a burst
+        // costs its producers no wake
+        nanosleep(&(TimeSpec){ .tv_nsec = SEGL_LOG_BATCH_NS }, NULL);
+        segl_log_drain();
+
+        uint64_t dropped = atomic_load_explicit(
+            &segl_log_dropped_count,
+            memory_order_relaxed
+        );
+        if (dropped != reported) {
+            char text[64];
+            snprintf(
+                text,
+                sizeof(text),
+                "dropped %llu log messages",
+                (unsigned long long)(dropped - reported)
+            );
+            segl_log_write(ANDROID_LOG_WARN, SEGL_ANDROID_LOG_ID, text);
+            reported = dropped;
+        }
+    }
+    return NULL;
+}
+
+bool segl_log_start(void) {
+    if (atomic_load_explicit(&segl_log_running, memory_order_acquire)) {
+        return true;
+    }
+    for (size_t i = 0; i < SEGL_LOG_RING_LEN; i += 1) {
+        atomic_store_explicit(&segl_log_ring[i].seq, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&segl_log_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&segl_log_tail, 0, memory_order_relaxed);
+    if (sem_init(&segl_log_wake, 0, 0) != 0) {
+        SEGL_LOG(ANDROID_LOG_WARN, "failed to create log semaphore");
+        return false;
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, segl_log_thread, NULL) != 0) {
+        sem_destroy(&segl_log_wake);
+        SEGL_LOG(ANDROID_LOG_WARN, "failed to start log thread");
+        return false;
+    }
+    // NOTE: the thread lives as long as the process, so that messages from
+    // the glue and other threads never race a shutdown
+    pthread_detach(thread);
+    atomic_store_explicit(&segl_log_running, true, memory_order_release);
+    return true;
+}
+
+void segl_log_flush(void) {
+    if (!atomic_load_explicit(&segl_log_running, memory_order_acquire)) {
+        return;
+    }
+    size_t head = atomic_load_explicit(&segl_log_head, memory_order_acquire);
+    int64_t deadline_ns = segl_log_now() + SEGL_LOG_FLUSH_NS;
+    while (
+        (ptrdiff_t)(
+            atomic_load_explicit(&segl_log_tail, memory_order_acquire) - head
+        ) < 0
+    ) {
+        if (segl_log_now() >= deadline_ns) {
+            return;
+        }
+        nanosleep(&(TimeSpec){ .tv_nsec = SEGL_LOG_FLUSH_POLL_NS }, NULL);
+    }
+}
+
+uint64_t segl_log_dropped(void) {
+    return atomic_load_explicit(&segl_log_dropped_count, memory_order_relaxed);
+}
+
+void segl_log_print(
+    SEglLogSite *site,
+    int prio,
+    const char *tag,
+    const char *fmt,
+    ...
+) {
+    // NOTE: errors are not rate limited, so a loop reporting each failure
+    // before exit reports all of them
+    unsigned suppressed = 0;
+    if (prio < ANDROID_LOG_ERROR && !segl_log_admit(site, &suppressed)) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    if (
+        prio < ANDROID_LOG_ERROR &&
+        atomic_load_explicit(&segl_log_running, memory_order_acquire)
+    ) {
+        if (!segl_log_push(prio, tag, suppressed, fmt, args)) {
+            atomic_fetch_add_explicit(
+                &segl_log_dropped_count,
+                1,
+                memory_order_relaxed
+            );
+        }
+    } else {
+        // NOTE: errors are usually followed by exit, so they skip the ring
+        // but keep their place after what is already queued
+        segl_log_flush();
+        char text[SEGL_LOG_MSG_LEN];
+        segl_log_format(text, suppressed, fmt, args);
+        segl_log_write(prio, tag, text);
+    }
+    va_end(args);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_LOG_H
+#define SEGL_LOG_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <android/log.h>
+
+// Logging that keeps liblog's syscall off the calling thread. SEGL_LOG
+// formats into a lock-free ring shared by all threads, and a background
+// thread started by segl_log_start drains it into logd (stderr on the
+// host). Until then, and for ANDROID_LOG_ERROR and above, messages are
+// written synchronously after the ring has been drained, so an error
+// followed by exit still reaches the log, in order.
+//
+// Each call site below ANDROID_LOG_ERROR admits SEGL_LOG_BURST messages
+// per SEGL_LOG_WINDOW_NS and counts the rest, which the next admitted
+// message reports as suppressed. Messages that find the ring full are counted as dropped
+// and reported by the drain thread.
+//
+// Call sites below SEGL_LOG_LEVEL compile to nothing; it defaults to
+// ANDROID_LOG_INFO with NDEBUG and ANDROID_LOG_VERBOSE without. SEGL_LOG
+// logs under SEGL_ANDROID_LOG_ID from segl.h, SEGL_LOG_TAG under any tag.
+//
+// NOTE: tags are kept by pointer, so they must be string literals (or
+// live as long)
+
+// must be a power of two
+#define SEGL_LOG_RING_LEN 256
+// longer messages are truncated
+#define SEGL_LOG_MSG_LEN 256
+#define SEGL_LOG_BURST 16
+#define SEGL_LOG_WINDOW_NS 1000000000LL
+
+#ifndef SEGL_LOG_LEVEL
+#ifdef NDEBUG
+#define SEGL_LOG_LEVEL ANDROID_LOG_INFO
+#else
+#define SEGL_LOG_LEVEL ANDROID_LOG_VERBOSE
+#endif
+#endif
+
+typedef struct {
+    _Atomic int64_t window_start_ns;
+    atomic_uint count;
+    atomic_uint suppressed;
+} SEglLogSite;
+
+// Starts the drain thread; later calls do nothing. Call it from one thread
+// at a time. Returns false if the thread could not be started, in which
+// case logging stays synchronous.
+bool segl_log_start(void);
+
+// Waits (at most 100 ms) until the drain thread has written everything
+// queued before the call, e.g. before the process may be killed.
+void segl_log_flush(void);
+
+// Messages lost to a full ring since startup.
+uint64_t segl_log_dropped(void);
+
+// A NULL site is never rate limited.
+__attribute__((format(printf, 4, 5)))
+void segl_log_print(
+    SEglLogSite *site,
+    int prio,
+    const char *tag,
+    const char *fmt,
+    ...
+);
+
+#define SEGL_LOG_TAG(prio, tag, ...) \
+    do { \
+        if ((prio) >= SEGL_LOG_LEVEL) { \
+            static SEglLogSite segl_log_site; \
+            segl_log_print(&segl_log_site, (prio), (tag), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define SEGL_LOG(prio, ...) \
+    SEGL_LOG_TAG((prio), SEGL_ANDROID_LOG_ID, __VA_ARGS__)
+
+#endif // SEGL_LOG_H
@@ -0,0 +1,432 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_PROCS_H
+#define SEGL_PROCS_H
+
+// Core EGL 1.4 entry points loaded from libEGL.so.
+//     X(pfn_type, name, required)
+#define SEGL_EGL_PROCS(X) \
+    X(PFNEGLCHOOSECONFIGPROC, ChooseConfig, true) \
+    X(PFNEGLCOPYBUFFERSPROC, CopyBuffers, true) \
+    X(PFNEGLCREATECONTEXTPROC, CreateContext, true) \
+    X(PFNEGLCREATEPBUFFERSURFACEPROC, CreatePbufferSurface, true) \
+    X(PFNEGLCREATEPIXMAPSURFACEPROC, CreatePixmapSurface, true) \
+    X(PFNEGLCREATEWINDOWSURFACEPROC, CreateWindowSurface, true) \
+    X(PFNEGLDESTROYCONTEXTPROC, DestroyContext, true) \
+    X(PFNEGLDESTROYSURFACEPROC, DestroySurface, true) \
+    X(PFNEGLGETCONFIGATTRIBPROC, GetConfigAttrib, true) \
+    X(PFNEGLGETCONFIGSPROC, GetConfigs, true) \
+    X(PFNEGLGETCURRENTDISPLAYPROC, GetCurrentDisplay, true) \
+    X(PFNEGLGETCURRENTSURFACEPROC, GetCurrentSurface, true) \
+    X(PFNEGLGETDISPLAYPROC, GetDisplay, true) \
+    X(PFNEGLGETERRORPROC, GetError, true) \
+    X(PFNEGLGETPROCADDRESSPROC, GetProcAddress, true) \
+    X(PFNEGLINITIALIZEPROC, Initialize, true) \
+    X(PFNEGLMAKECURRENTPROC, MakeCurrent, true) \
+    X(PFNEGLQUERYCONTEXTPROC, QueryContext, true) \
+    X(PFNEGLQUERYSTRINGPROC, QueryString, true) \
+    X(PFNEGLQUERYSURFACEPROC, QuerySurface, true) \
+    X(PFNEGLSURFACEATTRIBPROC, SurfaceAttrib, true) \
+    X(PFNEGLSWAPBUFFERSPROC, SwapBuffers, true) \
+    X(PFNEGLSWAPINTERVALPROC, SwapInterval, true) \
+    X(PFNEGLTERMINATEPROC, Terminate, true) \
+    X(PFNEGLWAITGLPROC, WaitGL, true) \
+    X(PFNEGLWAITNATIVEPROC, WaitNative, true)
+
+// Core OpenGL ES 2.0 entry points loaded through eglGetProcAddress. The
+// parameter and argument lists allow lazy trampolines to be generated.
+//     XR(pfn_type, return_type, name, params, args)
+//     XV(pfn_type, name, params, args)
+#define SGL_GL_PROCS(XR, XV) \
+    XV(PFNGLACTIVETEXTUREPROC, ActiveTexture, (GLenum texture), (texture)) \
+    XV(PFNGLATTACHSHADERPROC, AttachShader, \
+        (GLuint program, GLuint shader), (program, shader)) \
+    XV(PFNGLBINDATTRIBLOCATIONPROC, BindAttribLocation, \
+        (GLuint program, GLuint index, const GLchar *name), \
+        (program, index, name)) \
+    XV(PFNGLBINDBUFFERPROC, BindBuffer, \
+        (GLenum target, GLuint buffer), (target, buffer)) \
+    XV(PFNGLBINDFRAMEBUFFERPROC, BindFramebuffer, \
+        (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+    XV(PFNGLBINDRENDERBUFFERPROC, BindRenderbuffer, \
+        (GLenum target, GLuint renderbuffer), (target, renderbuffer)) \
+    XV(PFNGLBINDTEXTUREPROC, BindTexture, \
+        (GLenum target, GLuint texture), (target, texture)) \
+    XV(PFNGLBLENDCOLORPROC, BlendColor, \
+        (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), \
+        (red, green, blue, alpha)) \
+    XV(PFNGLBLENDEQUATIONPROC, BlendEquation, (GLenum mode), (mode)) \
+    XV(PFNGLBLENDEQUATIONSEPARATEPROC, BlendEquationSeparate, \
+        (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha)) \
+    XV(PFNGLBLENDFUNCPROC, BlendFunc, \
+        (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+    XV(PFNGLBLENDFUNCSEPARATEPROC, BlendFuncSeparate, \
+        (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, \
+            GLenum dfactorAlpha), \
+        (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha)) \
+    XV(PFNGLBUFFERDATAPROC, BufferData, \
+        (GLenum target, GLsizeiptr size, const void *data, GLenum usage), \
+        (target, size, data, usage)) \
+    XV(PFNGLBUFFERSUBDATAPROC, BufferSubData, \
+        (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), \
+        (target, offset, size, data)) \
+    XR(PFNGLCHECKFRAMEBUFFERSTATUSPROC, GLenum, CheckFramebufferStatus, \
+        (GLenum target), (target)) \
+    XV(PFNGLCLEARPROC, Clear, (GLbitfield mask), (mask)) \
+    XV(PFNGLCLEARCOLORPROC, ClearColor, \
+        (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), \
+        (red, green, blue, alpha)) \
+    XV(PFNGLCLEARDEPTHFPROC, ClearDepthf, (GLfloat d), (d)) \
+    XV(PFNGLCLEARSTENCILPROC, ClearStencil, (GLint s), (s)) \
+    XV(PFNGLCOLORMASKPROC, ColorMask, \
+        (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), \
+        (red, green, blue, alpha)) \
+    XV(PFNGLCOMPILESHADERPROC, CompileShader, (GLuint shader), (shader)) \
+    XV(PFNGLCOMPRESSEDTEXIMAGE2DPROC, CompressedTexImage2D, \
+        (GLenum target, GLint level, GLenum internalformat, GLsizei width, \
+            GLsizei height, GLint border, GLsizei imageSize, \
+            const void *data), \
+        (target, level, internalformat, width, height, border, imageSize, \
+            data)) \
+    XV(PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, CompressedTexSubImage2D, \
+        (GLenum target, GLint level, GLint xoffset, GLint yoffset, \
+            GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, \
+            const void *data), \
+        (target, level, xoffset, yoffset, width, height, format, imageSize, \
+            data)) \
+    XV(PFNGLCOPYTEXIMAGE2DPROC, CopyTexImage2D, \
+        (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, \
+            GLsizei width, GLsizei height, GLint border), \
+        (target, level, internalformat, x, y, width, height, border)) \
+    XV(PFNGLCOPYTEXSUBIMAGE2DPROC, CopyTexSubImage2D, \
+        (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, \
+            GLint y, GLsizei width, GLsizei height), \
+        (target, level, xoffset, yoffset, x, y, width, height)) \
+    XR(PFNGLCREATEPROGRAMPROC, GLuint, CreateProgram, (void), ()) \
+    XR(PFNGLCREATESHADERPROC, GLuint, CreateShader, (GLenum type), (type)) \
+    XV(PFNGLCULLFACEPROC, CullFace, (GLenum mode), (mode)) \
+    XV(PFNGLDELETEBUFFERSPROC, DeleteBuffers, \
+        (GLsizei n, const GLuint *buffers), (n, buffers)) \
+    XV(PFNGLDELETEFRAMEBUFFERSPROC, DeleteFramebuffers, \
+        (GLsizei n, const GLuint *framebuffers), (n, framebuffers)) \
+    XV(PFNGLDELETEPROGRAMPROC, DeleteProgram, (GLuint program), (program)) \
+    XV(PFNGLDELETERENDERBUFFERSPROC, DeleteRenderbuffers, \
+        (GLsizei n, const GLuint *renderbuffers), (n, renderbuffers)) \
+    XV(PFNGLDELETESHADERPROC, DeleteShader, (GLuint shader), (shader)) \
+    XV(PFNGLDELETETEXTURESPROC, DeleteTextures, \
+        (GLsizei n, const GLuint *textures), (n, textures)) \
+    XV(PFNGLDEPTHFUNCPROC, DepthFunc, (GLenum func), (func)) \
+    XV(PFNGLDEPTHMASKPROC, DepthMask, (GLboolean flag), (flag)) \
+    XV(PFNGLDEPTHRANGEFPROC, DepthRangef, (GLfloat n, GLfloat f), (n, f)) \
+    XV(PFNGLDETACHSHADERPROC, DetachShader, \
+        (GLuint program, GLuint shader), (program, shader)) \
+    XV(PFNGLDISABLEPROC, Disable, (GLenum cap), (cap)) \
+    XV(PFNGLDISABLEVERTEXATTRIBARRAYPROC, DisableVertexAttribArray, \
+        (GLuint index), (index)) \
+    XV(PFNGLDRAWARRAYSPROC, DrawArrays, \
+        (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+    XV(PFNGLDRAWELEMENTSPROC, DrawElements, \
+        (GLenum mode, GLsizei count, GLenum type, const void *indices), \
+        (mode, count, type, indices)) \
+    XV(PFNGLENABLEPROC, Enable, (GLenum cap), (cap)) \
+    XV(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray, \
+        (GLuint index), (index)) \
+    XV(PFNGLFINISHPROC, Finish, (void), ()) \
+    XV(PFNGLFLUSHPROC, Flush, (void), ()) \
+    XV(PFNGLFRAMEBUFFERRENDERBUFFERPROC, FramebufferRenderbuffer, \
+        (GLenum target, GLenum attachment, GLenum renderbuffertarget, \
+            GLuint renderbuffer), \
+        (target, attachment, renderbuffertarget, renderbuffer)) \
+    XV(PFNGLFRAMEBUFFERTEXTURE2DPROC, FramebufferTexture2D, \
+        (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, \
+            GLint level), \
+        (target, attachment, textarget, texture, level)) \
+    XV(PFNGLFRONTFACEPROC, FrontFace, (GLenum mode), (mode)) \
+    XV(PFNGLGENBUFFERSPROC, GenBuffers, \
+        (GLsizei n, GLuint *buffers), (n, buffers)) \
+    XV(PFNGLGENERATEMIPMAPPROC, GenerateMipmap, (GLenum target), (target)) \
+    XV(PFNGLGENFRAMEBUFFERSPROC, GenFramebuffers, \
+        (GLsizei n, GLuint *framebuffers), (n, framebuffers)) \
+    XV(PFNGLGENRENDERBUFFERSPROC, GenRenderbuffers, \
+        (GLsizei n, GLuint *renderbuffers), (n, renderbuffers)) \
+    XV(PFNGLGENTEXTURESPROC, GenTextures, \
+        (GLsizei n, GLuint *textures), (n, textures)) \
+    XV(PFNGLGETACTIVEATTRIBPROC, GetActiveAttrib, \
+        (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, \
+            GLint *size, GLenum *type, GLchar *name), \
+        (program, index, bufSize, length, size, type, name)) \
+    XV(PFNGLGETACTIVEUNIFORMPROC, GetActiveUniform, \
+        (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, \
+            GLint *size, GLenum *type, GLchar *name), \
+        (program, index, bufSize, length, size, type, name)) \
+    XV(PFNGLGETATTACHEDSHADERSPROC, GetAttachedShaders, \
+        (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders), \
+        (program, maxCount, count, shaders)) \
+    XR(PFNGLGETATTRIBLOCATIONPROC, GLint, GetAttribLocation, \
+        (GLuint program, const GLchar *name), (program, name)) \
+    XV(PFNGLGETBOOLEANVPROC, GetBooleanv, \
+        (GLenum pname, GLboolean *data), (pname, data)) \
+    XV(PFNGLGETBUFFERPARAMETERIVPROC, GetBufferParameteriv, \
+        (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    XR(PFNGLGETERRORPROC, GLenum, GetError, (void), ()) \
+    XV(PFNGLGETFLOATVPROC, GetFloatv, \
+        (GLenum pname, GLfloat *data), (pname, data)) \
+    XV(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC, \
+        GetFramebufferAttachmentParameteriv, \
+        (GLenum target, GLenum attachment, GLenum pname, GLint *params), \
+        (target, attachment, pname, params)) \
+    XV(PFNGLGETINTEGERVPROC, GetIntegerv, \
+        (GLenum pname, GLint *data), (pname, data)) \
+    XV(PFNGLGETPROGRAMIVPROC, GetProgramiv, \
+        (GLuint program, GLenum pname, GLint *params), \
+        (program, pname, params)) \
+    XV(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog, \
+        (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog), \
+        (program, bufSize, length, infoLog)) \
+    XV(PFNGLGETRENDERBUFFERPARAMETERIVPROC, GetRenderbufferParameteriv, \
+        (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    XV(PFNGLGETSHADERIVPROC, GetShaderiv, \
+        (GLuint shader, GLenum pname, GLint *params), (shader, pname, params)) \
+    XV(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog, \
+        (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog), \
+        (shader, bufSize, length, infoLog)) \
+    XV(PFNGLGETSHADERPRECISIONFORMATPROC, GetShaderPrecisionFormat, \
+        (GLenum shadertype, GLenum precisiontype, GLint *range, \
+            GLint *precision), \
+        (shadertype, precisiontype, range, precision)) \
+    XV(PFNGLGETSHADERSOURCEPROC, GetShaderSource, \
+        (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source), \
+        (shader, bufSize, length, source)) \
+    XR(PFNGLGETSTRINGPROC, const GLubyte *, GetString, (GLenum name), (name)) \
+    XV(PFNGLGETTEXPARAMETERFVPROC, GetTexParameterfv, \
+        (GLenum target, GLenum pname, GLfloat *params), \
+        (target, pname, params)) \
+    XV(PFNGLGETTEXPARAMETERIVPROC, GetTexParameteriv, \
+        (GLenum target, GLenum pname, GLint *params), (target, pname, params)) \
+    XV(PFNGLGETUNIFORMFVPROC, GetUniformfv, \
+        (GLuint program, GLint location, GLfloat *params), \
+        (program, location, params)) \
+    XV(PFNGLGETUNIFORMIVPROC, GetUniformiv, \
+        (GLuint program, GLint location, GLint *params), \
+        (program, location, params)) \
+    XR(PFNGLGETUNIFORMLOCATIONPROC, GLint, GetUniformLocation, \
+        (GLuint program, const GLchar *name), (program, name)) \
+    XV(PFNGLGETVERTEXATTRIBFVPROC, GetVertexAttribfv, \
+        (GLuint index, GLenum pname, GLfloat *params), (index, pname, params)) \
+    XV(PFNGLGETVERTEXATTRIBIVPROC, GetVertexAttribiv, \
+        (GLuint index, GLenum pname, GLint *params), (index, pname, params)) \
+    XV(PFNGLGETVERTEXATTRIBPOINTERVPROC, GetVertexAttribPointerv, \
+        (GLuint index, GLenum pname, void **pointer), (index, pname, pointer)) \
+    XV(PFNGLHINTPROC, Hint, (GLenum target, GLenum mode), (target, mode)) \
+    XR(PFNGLISBUFFERPROC, GLboolean, IsBuffer, (GLuint buffer), (buffer)) \
+    XR(PFNGLISENABLEDPROC, GLboolean, IsEnabled, (GLenum cap), (cap)) \
+    XR(PFNGLISFRAMEBUFFERPROC, GLboolean, IsFramebuffer, \
+        (GLuint framebuffer), (framebuffer)) \
+    XR(PFNGLISPROGRAMPROC, GLboolean, IsProgram, (GLuint program), (program)) \
+    XR(PFNGLISRENDERBUFFERPROC, GLboolean, IsRenderbuffer, \
+        (GLuint renderbuffer), (renderbuffer)) \
+    XR(PFNGLISSHADERPROC, GLboolean, IsShader, (GLuint shader), (shader)) \
+    XR(PFNGLISTEXTUREPROC, GLboolean, IsTexture, (GLuint texture), (texture)) \
+    XV(PFNGLLINEWIDTHPROC, LineWidth, (GLfloat width), (width)) \
+    XV(PFNGLLINKPROGRAMPROC, LinkProgram, (GLuint program), (program)) \
+    XV(PFNGLPIXELSTOREIPROC, PixelStorei, \
+        (GLenum pname, GLint param), (pname, param)) \
+    XV(PFNGLPOLYGONOFFSETPROC, PolygonOffset, \
+        (GLfloat factor, GLfloat units), (factor, units)) \
+    XV(PFNGLREADPIXELSPROC, ReadPixels, \
+        (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, \
+            GLenum type, void *pixels), \
+        (x, y, width, height, format, type, pixels)) \
+    XV(PFNGLRELEASESHADERCOMPILERPROC, ReleaseShaderCompiler, (void), ()) \
+    XV(PFNGLRENDERBUFFERSTORAGEPROC, RenderbufferStorage, \
+        (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), \
+        (target, internalformat, width, height)) \
+    XV(PFNGLSAMPLECOVERAGEPROC, SampleCoverage, \
+        (GLfloat value, GLboolean invert), (value, invert)) \
+    XV(PFNGLSCISSORPROC, Scissor, \
+        (GLint x, GLint y, GLsizei width, GLsizei height), \
+        (x, y, width, height)) \
+    XV(PFNGLSHADERBINARYPROC, ShaderBinary, \
+        (GLsizei count, const GLuint *shaders, GLenum binaryFormat, \
+            const void *binary, GLsizei length), \
+        (count, shaders, binaryFormat, binary, length)) \
+    XV(PFNGLSHADERSOURCEPROC, ShaderSource, \
+        (GLuint shader, GLsizei count, const GLchar *const*string, \
+            const GLint *length), \
+        (shader, count, string, length)) \
+    XV(PFNGLSTENCILFUNCPROC, StencilFunc, \
+        (GLenum func, GLint ref, GLuint mask), (func, ref, mask)) \
+    XV(PFNGLSTENCILFUNCSEPARATEPROC, StencilFuncSeparate, \
+        (GLenum face, GLenum func, GLint ref, GLuint mask), \
+        (face, func, ref, mask)) \
+    XV(PFNGLSTENCILMASKPROC, StencilMask, (GLuint mask), (mask)) \
+    XV(PFNGLSTENCILMASKSEPARATEPROC, StencilMaskSeparate, \
+        (GLenum face, GLuint mask), (face, mask)) \
+    XV(PFNGLSTENCILOPPROC, StencilOp, \
+        (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass)) \
+    XV(PFNGLSTENCILOPSEPARATEPROC, StencilOpSeparate, \
+        (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), \
+        (face, sfail, dpfail, dppass)) \
+    XV(PFNGLTEXIMAGE2DPROC, TexImage2D, \
+        (GLenum target, GLint level, GLint internalformat, GLsizei width, \
+            GLsizei height, GLint border, GLenum format, GLenum type, \
+            const void *pixels), \
+        (target, level, internalformat, width, height, border, format, type, \
+            pixels)) \
+    XV(PFNGLTEXPARAMETERFPROC, TexParameterf, \
+        (GLenum target, GLenum pname, GLfloat param), (target, pname, param)) \
+    XV(PFNGLTEXPARAMETERFVPROC, TexParameterfv, \
+        (GLenum target, GLenum pname, const GLfloat *params), \
+        (target, pname, params)) \
+    XV(PFNGLTEXPARAMETERIPROC, TexParameteri, \
+        (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+    XV(PFNGLTEXPARAMETERIVPROC, TexParameteriv, \
+        (GLenum target, GLenum pname, const GLint *params), \
+        (target, pname, params)) \
+    XV(PFNGLTEXSUBIMAGE2DPROC, TexSubImage2D, \
+        (GLenum target, GLint level, GLint xoffset, GLint yoffset, \
+            GLsizei width, GLsizei height, GLenum format, GLenum type, \
+            const void *pixels), \
+        (target, level, xoffset, yoffset, width, height, format, type, \
+            pixels)) \
+    XV(PFNGLUNIFORM1FPROC, Uniform1f, \
+        (GLint location, GLfloat v0), (location, v0)) \
+    XV(PFNGLUNIFORM1FVPROC, Uniform1fv, \
+        (GLint location, GLsizei count, const GLfloat *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM1IPROC, Uniform1i, \
+        (GLint location, GLint v0), (location, v0)) \
+    XV(PFNGLUNIFORM1IVPROC, Uniform1iv, \
+        (GLint location, GLsizei count, const GLint *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM2FPROC, Uniform2f, \
+        (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1)) \
+    XV(PFNGLUNIFORM2FVPROC, Uniform2fv, \
+        (GLint location, GLsizei count, const GLfloat *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM2IPROC, Uniform2i, \
+        (GLint location, GLint v0, GLint v1), (location, v0, v1)) \
+    XV(PFNGLUNIFORM2IVPROC, Uniform2iv, \
+        (GLint location, GLsizei count, const GLint *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM3FPROC, Uniform3f, \
+        (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), \
+        (location, v0, v1, v2)) \
+    XV(PFNGLUNIFORM3FVPROC, Uniform3fv, \
+        (GLint location, GLsizei count, const GLfloat *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM3IPROC, Uniform3i, \
+        (GLint location, GLint v0, GLint v1, GLint v2), \
+        (location, v0, v1, v2)) \
+    XV(PFNGLUNIFORM3IVPROC, Uniform3iv, \
+        (GLint location, GLsizei count, const GLint *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM4FPROC, Uniform4f, \
+        (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), \
+        (location, v0, v1, v2, v3)) \
+    XV(PFNGLUNIFORM4FVPROC, Uniform4fv, \
+        (GLint location, GLsizei count, const GLfloat *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORM4IPROC, Uniform4i, \
+        (GLint location, GLint v0, GLint v1, GLint v2, GLint v3), \
+        (location, v0, v1, v2, v3)) \
+    XV(PFNGLUNIFORM4IVPROC, Uniform4iv, \
+        (GLint location, GLsizei count, const GLint *value), \
+        (location, count, value)) \
+    XV(PFNGLUNIFORMMATRIX2FVPROC, UniformMatrix2fv, \
+        (GLint location, GLsizei count, GLboolean transpose, \
+            const GLfloat *value), \
+        (location, count, transpose, value)) \
+    XV(PFNGLUNIFORMMATRIX3FVPROC, UniformMatrix3fv, \
+        (GLint location, GLsizei count, GLboolean transpose, \
+            const GLfloat *value), \
+        (location, count, transpose, value)) \
+    XV(PFNGLUNIFORMMATRIX4FVPROC, UniformMatrix4fv, \
+        (GLint location, GLsizei count, GLboolean transpose, \
+            const GLfloat *value), \
+        (location, count, transpose, value)) \
+    XV(PFNGLUSEPROGRAMPROC, UseProgram, (GLuint program), (program)) \
+    XV(PFNGLVALIDATEPROGRAMPROC, ValidateProgram, (GLuint program), (program)) \
+    XV(PFNGLVERTEXATTRIB1FPROC, VertexAttrib1f, \
+        (GLuint index, GLfloat x), (index, x)) \
+    XV(PFNGLVERTEXATTRIB1FVPROC, VertexAttrib1fv, \
+        (GLuint index, const GLfloat *v), (index, v)) \
+    XV(PFNGLVERTEXATTRIB2FPROC, VertexAttrib2f, \
+        (GLuint index, GLfloat x, GLfloat y), (index, x, y)) \
+    XV(PFNGLVERTEXATTRIB2FVPROC, VertexAttrib2fv, \
+        (GLuint index, const GLfloat *v), (index, v)) \
+    XV(PFNGLVERTEXATTRIB3FPROC, VertexAttrib3f, \
+        (GLuint index, GLfloat x, GLfloat y, GLfloat z), (index, x, y, z)) \
+    XV(PFNGLVERTEXATTRIB3FVPROC, VertexAttrib3fv, \
+        (GLuint index, const GLfloat *v), (index, v)) \
+    XV(PFNGLVERTEXATTRIB4FPROC, VertexAttrib4f, \
+        (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), \
+        (index, x, y, z, w)) \
+    XV(PFNGLVERTEXATTRIB4FVPROC, VertexAttrib4fv, \
+        (GLuint index, const GLfloat *v), (index, v)) \
+    XV(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer, \
+        (GLuint index, GLint size, GLenum type, GLboolean normalized, \
+            GLsizei stride, const void *pointer), \
+        (index, size, type, normalized, stride, pointer)) \
+    XV(PFNGLVIEWPORTPROC, Viewport, \
+        (GLint x, GLint y, GLsizei width, GLsizei height), \
+        (x, y, width, height))
+
+// Optional EGL and GLES extensions, in capability bitmap order.
+//     X(id, name)
+#define SEGL_EXTS(X) \
+    X(EGL_KHR_FENCE_SYNC, "EGL_KHR_fence_sync") \
+    X(EGL_KHR_PARTIAL_UPDATE, "EGL_KHR_partial_update") \
+    X(EGL_ANDROID_PRESENTATION_TIME, "EGL_ANDROID_presentation_time") \
+    X(EGL_EXT_BUFFER_AGE, "EGL_EXT_buffer_age") \
+    X(EGL_KHR_SWAP_BUFFERS_WITH_DAMAGE, "EGL_KHR_swap_buffers_with_damage") \
+    X(EGL_ANDROID_GET_FRAME_TIMESTAMPS, "EGL_ANDROID_get_frame_timestamps") \
+    X(EGL_KHR_SURFACELESS_CONTEXT, "EGL_KHR_surfaceless_context") \
+    X(GL_EXT_DISCARD_FRAMEBUFFER, "GL_EXT_discard_framebuffer") \
+    X(GL_OES_VERTEX_ARRAY_OBJECT, "GL_OES_vertex_array_object")
+
+// Entry points of the optional extensions, loaded only when the extension is
+// advertised.
+//     X(pfn_type, prefix, name, ext_id)
+#define SEGL_EXT_PROCS(X) \
+    X(PFNEGLCREATESYNCKHRPROC, egl, CreateSyncKHR, EGL_KHR_FENCE_SYNC) \
+    X(PFNEGLDESTROYSYNCKHRPROC, egl, DestroySyncKHR, EGL_KHR_FENCE_SYNC) \
+    X(PFNEGLCLIENTWAITSYNCKHRPROC, egl, ClientWaitSyncKHR, EGL_KHR_FENCE_SYNC) \
+    X(PFNEGLGETSYNCATTRIBKHRPROC, egl, GetSyncAttribKHR, EGL_KHR_FENCE_SYNC) \
+    X(PFNEGLSETDAMAGEREGIONKHRPROC, egl, SetDamageRegionKHR, \
+        EGL_KHR_PARTIAL_UPDATE) \
+    X(PFNEGLPRESENTATIONTIMEANDROIDPROC, egl, PresentationTimeANDROID, \
+        EGL_ANDROID_PRESENTATION_TIME) \
+    X(PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC, egl, SwapBuffersWithDamageKHR, \
+        EGL_KHR_SWAP_BUFFERS_WITH_DAMAGE) \
+    X(PFNEGLGETNEXTFRAMEIDANDROIDPROC, egl, GetNextFrameIdANDROID, \
+        EGL_ANDROID_GET_FRAME_TIMESTAMPS) \
+    X(PFNEGLGETFRAMETIMESTAMPSANDROIDPROC, egl, GetFrameTimestampsANDROID, \
+        EGL_ANDROID_GET_FRAME_TIMESTAMPS) \
+    X(PFNEGLGETFRAMETIMESTAMPSUPPORTEDANDROIDPROC, egl, \
+        GetFrameTimestampSupportedANDROID, EGL_ANDROID_GET_FRAME_TIMESTAMPS) \
+    X(PFNGLDISCARDFRAMEBUFFEREXTPROC, gl, DiscardFramebufferEXT, \
+        GL_EXT_DISCARD_FRAMEBUFFER) \
+    X(PFNGLBINDVERTEXARRAYOESPROC, gl, BindVertexArrayOES, \
+        GL_OES_VERTEX_ARRAY_OBJECT) \
+    X(PFNGLDELETEVERTEXARRAYSOESPROC, gl, DeleteVertexArraysOES, \
+        GL_OES_VERTEX_ARRAY_OBJECT) \
+    X(PFNGLGENVERTEXARRAYSOESPROC, gl, GenVertexArraysOES, \
+        GL_OES_VERTEX_ARRAY_OBJECT) \
+    X(PFNGLISVERTEXARRAYOESPROC, gl, IsVertexArrayOES, \
+        GL_OES_VERTEX_ARRAY_OBJECT)
+
+#endif // SEGL_PROCS_H
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl_scale.h"
+
+static float segl_scale_clamp(const SEglScale *scale, float value) {
+    if (value < scale->min_scale) {
+        return scale->min_scale;
+    }
+    return value > scale->max_scale ? scale->max_scale : value;
+}
+
+static void segl_scale_reset(SEglScale *scale) {
+    scale->nsamples = 0;
+    scale->next = 0;
+    scale->sum = 0;
+}
+
+static bool segl_scale_set(SEglScale *scale, float value) {
+    // NOTE: snapped to the step so repeated steps do not drift
+    value = roundf(value / SEGL_SCALE_STEP) * SEGL_SCALE_STEP;
+    value = segl_scale_clamp(scale, value);
+    segl_scale_reset(scale);
+    if (value == scale->scale) {
+        return false;
+    }
+    scale->scale = value;
+    scale->changes += 1;
+    return true;
+}
+
+void segl_scale_init(
+    SEglScale *scale,
+    int64_t target_ns,
+    float min_scale,
+    float max_scale
+) {
+    *scale = (SEglScale){
+        .target_ns = target_ns,
+        .min_scale = min_scale,
+        .max_scale = max_scale,
+        .scale = max_scale,
+    };
+}
+
+bool segl_scale_frame(SEglScale *scale, int64_t frame_ns) {
+    if (scale->pinned) {
+        return false;
+    }
+
+    if (scale->nsamples == SEGL_SCALE_WINDOW) {
+        scale->sum -= scale->samples[scale->next];
+    } else {
+        scale->nsamples += 1;
+    }
+    scale->samples[scale->next] = frame_ns;
+    scale->sum += frame_ns;
+    scale->next = (scale->next + 1) % SEGL_SCALE_WINDOW;
+    if (scale->nsamples < SEGL_SCALE_WINDOW) {
+        return false;
+    }
+
+    float load = (float)scale->sum / (float)SEGL_SCALE_WINDOW /
+        (float)scale->target_ns;
+    if (load > SEGL_SCALE_HIGH) {
+        // NOTE: rounded down, and at least one step, so an overloaded GPU
+        // never waits a second window for relief
+        float value = scale->scale * sqrtf(SEGL_SCALE_GOAL / load);
+        value = floorf(value / SEGL_SCALE_STEP + 0.001f) * SEGL_SCALE_STEP;
+        if (value > scale->scale - SEGL_SCALE_STEP) {
+            value = scale->scale - SEGL_SCALE_STEP;
+        }
+        return segl_scale_set(scale, value);
+    }
+    if (load < SEGL_SCALE_LOW && scale->scale < scale->max_scale) {
+        return segl_scale_set(scale, scale->scale + SEGL_SCALE_STEP);
+    }
+    return false;
+}
+
+bool segl_scale_pin(SEglScale *scale, float value) {
+    scale->pinned = true;
+    segl_scale_reset(scale);
+    value = segl_scale_clamp(scale, value);
+    if (value == scale->scale) {
+        return false;
+    }
+    scale->scale = value;
+    scale->changes += 1;
+    return true;
+}
+
+void segl_scale_unpin(SEglScale *scale) {
+    scale->pinned = false;
+    segl_scale_reset(scale);
+}
+
+int64_t segl_scale_average(const SEglScale *scale) {
+    if (scale->nsamples == 0) {
+        return 0;
+    }
+    return scale->sum / (int64_t)scale->nsamples;
+}
+
+void segl_scale_size(
+    const SEglScale *scale,
+    int32_t width,
+    int32_t height,
+    int32_t *scaled_width,
+    int32_t *scaled_height
+) {
+    int32_t w = (int32_t)((float)width * scale->scale + 0.5f) & ~1;
+    int32_t h = (int32_t)((float)height * scale->scale + 0.5f) & ~1;
+    *scaled_width = w < 2 ? 2 : w;
+    *scaled_height = h < 2 ? 2 : h;
+}
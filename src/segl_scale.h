@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_SCALE_H
+#define SEGL_SCALE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Frames averaged before each decision.
+#define SEGL_SCALE_WINDOW 32
+// Scales are multiples of this, so small swings do not resize the buffers.
+#define SEGL_SCALE_STEP 0.05f
+
+// Dynamic resolution: picks a render scale for the window buffers from a
+// rolling average of frame times, which must measure GPU work rather than
+// display pacing, e.g. swap to GPU complete from segl_timing. Frame time is
+// taken to grow with the pixel count, that is with the scale squared. Above
+// SEGL_SCALE_HIGH of the target the scale drops straight to where the
+// frames would take SEGL_SCALE_GOAL of it; below SEGL_SCALE_LOW it grows
+// one step at a time. The gap between the two is the hysteresis.
+typedef struct {
+    int64_t target_ns;
+    float min_scale;
+    float max_scale;
+    float scale;
+    // segl_scale_pin holds the scale until segl_scale_unpin
+    bool pinned;
+    int64_t samples[SEGL_SCALE_WINDOW];
+    size_t nsamples;
+    size_t next;
+    int64_t sum;
+    uint64_t changes;
+} SEglScale;
+
+#define SEGL_SCALE_HIGH 0.9f
+#define SEGL_SCALE_GOAL 0.8f
+#define SEGL_SCALE_LOW 0.6f
+
+// Starts at max_scale.
+void segl_scale_init(
+    SEglScale *scale,
+    int64_t target_ns,
+    float min_scale,
+    float max_scale
+);
+// Adds one frame's time and returns true when the scale changed. The
+// samples are dropped on every change, since they were taken at the old
+// scale.
+bool segl_scale_frame(SEglScale *scale, int64_t frame_ns);
+// Holds the scale, clamped to the bounds, until segl_scale_unpin. Returns
+// true when the scale changed.
+bool segl_scale_pin(SEglScale *scale, float value);
+void segl_scale_unpin(SEglScale *scale);
+// Average of the samples since the last change, 0 without any.
+int64_t segl_scale_average(const SEglScale *scale);
+// Scales a native size, rounding to even sizes of at least 2x2.
+void segl_scale_size(
+    const SEglScale *scale,
+    int32_t width,
+    int32_t height,
+    int32_t *scaled_width,
+    int32_t *scaled_height
+);
+
+#endif // SEGL_SCALE_H
@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl.h"
+#include "segl_surface.h"
+
+static void segl_surface_notify(const SEglSurfaceState *state) {
+    for (size_t i = 0; i < state->ncallbacks; i += 1) {
+        state->callbacks[i].fn(state, state->callbacks[i].userdata);
+    }
+}
+
+static EGLint segl_surface_clamp(int32_t value, EGLint max) {
+    if (value < 0) {
+        return 0;
+    }
+    return value > max ? max : (EGLint)value;
+}
+
+static int32_t segl_surface_scale(int32_t value, EGLint size, int32_t from) {
+    if (from <= 0) {
+        return value;
+    }
+    return (int32_t)((int64_t)value * size / from);
+}
+
+// Scales the content rect to the buffers, flips it to a bottom-left origin
+// and clips it to the surface. Returns whether it changed.
+static bool segl_surface_content_apply(SEglSurfaceState *state) {
+    SEglRect content = {
+        .width = state->width,
+        .height = state->height,
+    };
+    if (state->content_set) {
+        EGLint width = state->width;
+        EGLint height = state->height;
+        int32_t left = segl_surface_scale(
+            state->content_left,
+            width,
+            state->window_width
+        );
+        int32_t right = segl_surface_scale(
+            state->content_right,
+            width,
+            state->window_width
+        );
+        int32_t top = segl_surface_scale(
+            state->content_top,
+            height,
+            state->window_height
+        );
+        int32_t bottom = segl_surface_scale(
+            state->content_bottom,
+            height,
+            state->window_height
+        );
+        EGLint x0 = segl_surface_clamp(left, width);
+        EGLint x1 = segl_surface_clamp(right, width);
+        EGLint y0 = segl_surface_clamp(height - bottom, height);
+        EGLint y1 = segl_surface_clamp(height - top, height);
+        content = (SEglRect){
+            .x = x0,
+            .y = y0,
+            .width = x1 > x0 ? x1 - x0 : 0,
+            .height = y1 > y0 ? y1 - y0 : 0,
+        };
+    }
+    bool changed = (
+        content.x != state->content.x ||
+        content.y != state->content.y ||
+        content.width != state->content.width ||
+        content.height != state->content.height
+    );
+    state->content = content;
+    return changed;
+}
+
+void segl_surface_init(SEglSurfaceState *state) {
+    *state = (SEglSurfaceState){ .stale = true };
+}
+
+bool segl_surface_on_resize(
+    SEglSurfaceState *state,
+    SEglResizeFn fn,
+    void *userdata
+) {
+    if (state->ncallbacks == SEGL_SURFACE_MAX_CALLBACKS) {
+        return false;
+    }
+    state->callbacks[state->ncallbacks] = (SEglResizeCallback){
+        .fn = fn,
+        .userdata = userdata,
+    };
+    state->ncallbacks += 1;
+    return true;
+}
+
+void segl_surface_invalidate(SEglSurfaceState *state) {
+    state->stale = true;
+}
+
+void segl_surface_reset(SEglSurfaceState *state) {
+    state->width = 0;
+    state->height = 0;
+    state->content = (SEglRect){ 0 };
+    state->stale = true;
+}
+
+bool segl_surface_update(
+    SEglSurfaceState *state,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable
+) {
+    if (!state->stale || segl_ctx->surface == EGL_NO_SURFACE) {
+        return false;
+    }
+    state->stale = false;
+    state->queries += 1;
+
+    EGLint width = 0;
+    EGLint height = 0;
+    segl_vtable->QuerySurface(
+        segl_ctx->display,
+        segl_ctx->surface,
+        EGL_WIDTH,
+        &width
+    );
+    segl_vtable->QuerySurface(
+        segl_ctx->display,
+        segl_ctx->surface,
+        EGL_HEIGHT,
+        &height
+    );
+    if (width == state->width && height == state->height) {
+        return false;
+    }
+    state->width = width;
+    state->height = height;
+    state->resizes += 1;
+    segl_surface_content_apply(state);
+    segl_surface_notify(state);
+    return true;
+}
+
+void segl_surface_content(
+    SEglSurfaceState *state,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom
+) {
+    state->content_set = true;
+    state->content_left = left;
+    state->content_top = top;
+    state->content_right = right;
+    state->content_bottom = bottom;
+    // NOTE: before the first size query there is nothing to clip to, the
+    // update that follows applies it
+    if (state->width > 0 && segl_surface_content_apply(state)) {
+        segl_surface_notify(state);
+    }
+}
+
+void segl_surface_window(
+    SEglSurfaceState *state,
+    int32_t width,
+    int32_t height
+) {
+    state->window_width = width;
+    state->window_height = height;
+    if (state->width > 0 && segl_surface_content_apply(state)) {
+        segl_surface_notify(state);
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_SURFACE_H
+#define SEGL_SURFACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "segl.h"
+
+#define SEGL_SURFACE_MAX_CALLBACKS 8
+
+struct SEglSurfaceState;
+
+// Called on the render thread after the size or content rect changed, to
+// rebuild the viewport and anything sized to the surface.
+typedef void (*SEglResizeFn)(
+    const struct SEglSurfaceState *state,
+    void *userdata
+);
+
+typedef struct {
+    SEglResizeFn fn;
+    void *userdata;
+} SEglResizeCallback;
+
+// Window surface size and content rect, cached between the commands that
+// change them so frames never query the window or surface:
+//     APP_CMD_INIT_WINDOW, APP_CMD_WINDOW_RESIZED, APP_CMD_CONFIG_CHANGED:
+//         segl_surface_invalidate(...)
+//     APP_CMD_CONTENT_RECT_CHANGED: segl_surface_content(...)
+//     after every swap: segl_surface_update(...)
+// A resized window only reaches EGL_WIDTH/EGL_HEIGHT once a buffer of the
+// new size is dequeued, which is why the query waits for the next swap.
+typedef struct SEglSurfaceState {
+    EGLint width;
+    EGLint height;
+    // the part not covered by system bars, the whole surface until
+    // segl_surface_content is called
+    SEglRect content;
+    // the size must be queried again
+    bool stale;
+    // the content rect as given, in window pixels with a top-left origin
+    bool content_set;
+    int32_t content_left;
+    int32_t content_top;
+    int32_t content_right;
+    int32_t content_bottom;
+    // native window size, when the buffers are scaled from it
+    int32_t window_width;
+    int32_t window_height;
+    SEglResizeCallback callbacks[SEGL_SURFACE_MAX_CALLBACKS];
+    size_t ncallbacks;
+    uint64_t queries;
+    uint64_t resizes;
+} SEglSurfaceState;
+
+void segl_surface_init(SEglSurfaceState *state);
+// Returns false when SEGL_SURFACE_MAX_CALLBACKS are already registered.
+bool segl_surface_on_resize(
+    SEglSurfaceState *state,
+    SEglResizeFn fn,
+    void *userdata
+);
+// Makes the next segl_surface_update query the surface size.
+void segl_surface_invalidate(SEglSurfaceState *state);
+// Forgets the size so the next segl_surface_update calls back even if it
+// did not change, e.g. for a new context that lost the GL state.
+void segl_surface_reset(SEglSurfaceState *state);
+// Queries EGL_WIDTH and EGL_HEIGHT when invalidated and calls back when
+// they changed. Returns whether they did.
+bool segl_surface_update(
+    SEglSurfaceState *state,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable
+);
+// Sets the content rect from window coordinates, e.g. android_app's
+// contentRect, calling back when it changed.
+// NOTE: with buffers scaled by ANativeWindow_setBuffersGeometry, see
+// segl_surface_window
+void segl_surface_content(
+    SEglSurfaceState *state,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom
+);
+
+// Sets the native window size the content rect is given in, so it can be
+// scaled to buffers that are smaller than the window; 0 means unscaled.
+void segl_surface_window(
+    SEglSurfaceState *state,
+    int32_t width,
+    int32_t height
+);
+
+#endif // SEGL_SURFACE_H
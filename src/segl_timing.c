@@ -0,0 +1,254 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "segl.h"
+#include "segl_log.h"
+#include "segl_timing.h"
+
+// NOTE: every name must be supported, otherwise the whole
+// eglGetFrameTimestampsANDROID query fails with EGL_BAD_PARAMETER
+static const EGLint segl_timing_names[] = {
+    EGL_REQUESTED_PRESENT_TIME_ANDROID,
+    EGL_RENDERING_COMPLETE_TIME_ANDROID,
+    EGL_COMPOSITION_LATCH_TIME_ANDROID,
+    EGL_DISPLAY_PRESENT_TIME_ANDROID,
+};
+
+static int64_t segl_timing_now(void) {
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000L * 1000L * 1000L + now.tv_nsec;
+}
+
+bool segl_timing_start(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+) {
+    // NOTE: frame ids belong to a surface, so older frames are unreachable
+    timing->enabled = false;
+    timing->head = 0;
+    timing->tail = 0;
+
+    if ((ext->caps & SEGL_CAP(EGL_ANDROID_GET_FRAME_TIMESTAMPS)) == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < countof(segl_timing_names); i += 1) {
+        if (
+            !ext->GetFrameTimestampSupportedANDROID(
+                segl_ctx->display,
+                segl_ctx->surface,
+                segl_timing_names[i]
+            )
+        ) {
+            SEGL_LOG(
+                ANDROID_LOG_WARN,
+                "frame timestamp 0x%x unsupported",
+                segl_timing_names[i]
+            );
+            return false;
+        }
+    }
+    if (
+        !segl_vtable->SurfaceAttrib(
+            segl_ctx->display,
+            segl_ctx->surface,
+            EGL_TIMESTAMPS_ANDROID,
+            EGL_TRUE
+        )
+    ) {
+        return false;
+    }
+
+    timing->enabled = true;
+    return true;
+}
+
+void segl_timing_frame(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglExt *ext,
+    int64_t present_ns
+) {
+    // NOTE: presentation times only need their own extension, so frames
+    // stay paced on drivers without (all) frame timestamps
+    if (
+        present_ns > 0 &&
+        (ext->caps & SEGL_CAP(EGL_ANDROID_PRESENTATION_TIME)) != 0
+    ) {
+        ext->PresentationTimeANDROID(
+            segl_ctx->display,
+            segl_ctx->surface,
+            present_ns
+        );
+    }
+    if (!timing->enabled) {
+        return;
+    }
+
+    EGLuint64KHR id;
+    if (
+        !ext->GetNextFrameIdANDROID(
+            segl_ctx->display,
+            segl_ctx->surface,
+            &id
+        )
+    ) {
+        return;
+    }
+
+    // NOTE: if timestamps stop resolving, the oldest pending frame is
+    // given up rather than stalling the ring
+    if (timing->head - timing->tail == SEGL_TIMING_RING_LEN) {
+        timing->tail += 1;
+    }
+    timing->frames[timing->head % SEGL_TIMING_RING_LEN] = (SEglFrameTiming){
+        .id = id,
+        .swap_ns = segl_timing_now(),
+        .requested_present_ns = EGL_TIMESTAMP_PENDING_ANDROID,
+        .gpu_complete_ns = EGL_TIMESTAMP_PENDING_ANDROID,
+        .latch_ns = EGL_TIMESTAMP_PENDING_ANDROID,
+        .present_ns = EGL_TIMESTAMP_PENDING_ANDROID,
+    };
+    timing->head += 1;
+}
+
+void segl_timing_poll(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglExt *ext
+) {
+    if (!timing->enabled) {
+        return;
+    }
+
+    // NOTE: frames complete in order, so the first pending one ends the scan
+    while (timing->tail < timing->head) {
+        SEglFrameTiming *frame = &timing->frames[
+            timing->tail % SEGL_TIMING_RING_LEN
+        ];
+        EGLnsecsANDROID values[countof(segl_timing_names)];
+        if (
+            !ext->GetFrameTimestampsANDROID(
+                segl_ctx->display,
+                segl_ctx->surface,
+                frame->id,
+                (EGLint)countof(segl_timing_names),
+                segl_timing_names,
+                values
+            )
+        ) {
+            // NOTE: the driver only keeps a few frames of history
+            for (size_t i = 0; i < countof(values); i += 1) {
+                values[i] = EGL_TIMESTAMP_INVALID_ANDROID;
+            }
+        }
+
+        bool pending = false;
+        for (size_t i = 0; i < countof(values); i += 1) {
+            pending = pending || values[i] == EGL_TIMESTAMP_PENDING_ANDROID;
+        }
+        if (pending) {
+            break;
+        }
+
+        frame->requested_present_ns = values[0];
+        frame->gpu_complete_ns = values[1];
+        frame->latch_ns = values[2];
+        frame->present_ns = values[3];
+        timing->tail += 1;
+    }
+}
+
+static int segl_percentile_cmp(const void *a, const void *b) {
+    int64_t lhs = *(const int64_t *)a;
+    int64_t rhs = *(const int64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+SEglPercentiles segl_percentiles(int64_t *values, size_t n) {
+    if (n == 0) {
+        return (SEglPercentiles){ 0 };
+    }
+    qsort(values, n, sizeof(*values), segl_percentile_cmp);
+    return (SEglPercentiles){
+        .p50 = values[(n - 1) * 50 / 100],
+        .p90 = values[(n - 1) * 90 / 100],
+        .p99 = values[(n - 1) * 99 / 100],
+        .max = values[n - 1],
+    };
+}
+
+static bool segl_timestamp_valid(EGLnsecsANDROID ns) {
+    return (
+        ns != EGL_TIMESTAMP_INVALID_ANDROID &&
+        ns != EGL_TIMESTAMP_PENDING_ANDROID
+    );
+}
+
+void segl_timing_report(const SEglTiming *timing, SEglTimingReport *report) {
+    int64_t present[SEGL_TIMING_RING_LEN];
+    int64_t gpu[SEGL_TIMING_RING_LEN];
+    int64_t latch[SEGL_TIMING_RING_LEN];
+    int64_t error[SEGL_TIMING_RING_LEN];
+    size_t npresent = 0;
+    size_t ngpu = 0;
+    size_t nlatch = 0;
+    size_t nerror = 0;
+
+    uint64_t first = 0;
+    if (timing->head > SEGL_TIMING_RING_LEN) {
+        first = timing->head - SEGL_TIMING_RING_LEN;
+    }
+    for (uint64_t i = first; i < timing->tail; i += 1) {
+        const SEglFrameTiming *frame = &timing->frames[
+            i % SEGL_TIMING_RING_LEN
+        ];
+        if (segl_timestamp_valid(frame->present_ns)) {
+            present[npresent] = frame->present_ns - frame->swap_ns;
+            npresent += 1;
+        }
+        if (segl_timestamp_valid(frame->gpu_complete_ns)) {
+            gpu[ngpu] = frame->gpu_complete_ns - frame->swap_ns;
+            ngpu += 1;
+        }
+        if (
+            segl_timestamp_valid(frame->latch_ns) &&
+            segl_timestamp_valid(frame->present_ns)
+        ) {
+            latch[nlatch] = frame->present_ns - frame->latch_ns;
+            nlatch += 1;
+        }
+        if (
+            segl_timestamp_valid(frame->requested_present_ns) &&
+            segl_timestamp_valid(frame->present_ns)
+        ) {
+            error[nerror] = frame->present_ns - frame->requested_present_ns;
+            nerror += 1;
+        }
+    }
+
+    report->frames = npresent;
+    report->swap_to_present = segl_percentiles(present, npresent);
+    report->swap_to_gpu_complete = segl_percentiles(gpu, ngpu);
+    report->latch_to_present = segl_percentiles(latch, nlatch);
+    report->present_error = segl_percentiles(error, nerror);
+}
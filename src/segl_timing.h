@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_TIMING_H
+#define SEGL_TIMING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "segl.h"
+
+// Frames remembered while their timestamps resolve, a power of two.
+#define SEGL_TIMING_RING_LEN 256
+
+// Display timeline of one swapped frame, all CLOCK_MONOTONIC ns. Times the
+// driver does not report are EGL_TIMESTAMP_INVALID_ANDROID.
+typedef struct {
+    EGLuint64KHR id;
+    // when eglSwapBuffers was called
+    int64_t swap_ns;
+    // eglPresentationTimeANDROID target, if one was set
+    EGLnsecsANDROID requested_present_ns;
+    EGLnsecsANDROID gpu_complete_ns;
+    EGLnsecsANDROID latch_ns;
+    EGLnsecsANDROID present_ns;
+} SEglFrameTiming;
+
+// Frame timing through EGL_ANDROID_get_frame_timestamps. Timestamps arrive
+// a few frames after the swap, so frames wait in a ring until every time
+// is known, then count towards the percentiles.
+typedef struct {
+    bool enabled;
+    SEglFrameTiming frames[SEGL_TIMING_RING_LEN];
+    // frames recorded, the next goes to frames[head % SEGL_TIMING_RING_LEN]
+    uint64_t head;
+    // oldest frame whose timestamps are still pending
+    uint64_t tail;
+} SEglTiming;
+
+typedef struct {
+    int64_t p50;
+    int64_t p90;
+    int64_t p99;
+    int64_t max;
+} SEglPercentiles;
+
+typedef struct {
+    size_t frames;
+    // swap call to first light on the display
+    SEglPercentiles swap_to_present;
+    // swap call to the GPU finishing the frame
+    SEglPercentiles swap_to_gpu_complete;
+    // compositor latch to first light on the display
+    SEglPercentiles latch_to_present;
+    // actual minus requested present time, for paced frames only
+    SEglPercentiles present_error;
+} SEglTimingReport;
+
+// Enables timestamps on the current surface; call again for every new
+// surface. Returns false when the driver cannot report them.
+bool segl_timing_start(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SEglExt *ext
+);
+// Call right before the swap. A non-zero present_ns asks the compositor
+// to show the frame at that time through EGL_ANDROID_presentation_time,
+// whether or not frame timing is enabled.
+void segl_timing_frame(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglExt *ext,
+    int64_t present_ns
+);
+// Resolves the timestamps of earlier frames that have become available.
+void segl_timing_poll(
+    SEglTiming *timing,
+    const SEglCtx *segl_ctx,
+    const SEglExt *ext
+);
+// Percentiles over the resolved frames still in the ring.
+void segl_timing_report(const SEglTiming *timing, SEglTimingReport *report);
+
+// Sorts values in place and returns p50/p90/p99/max, zeros when n is 0.
+SEglPercentiles segl_percentiles(int64_t *values, size_t n);
+
+#endif // SEGL_TIMING_H
@@ -0,0 +1,497 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "segl_trace.h"
+
+#ifdef SEGL_TRACING
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "segl.h"
+#include "segl_log.h"
+
+#ifdef SEGL_ATRACE
+
+typedef struct {
+    void (*beginSection)(const char *section_name);
+    void (*endSection)(void);
+    void (*setCounter)(const char *counter_name, int64_t counter_value);
+} SEglATrace;
+
+static SEglATrace segl_atrace;
+
+#ifdef __ANDROID__
+
+typedef struct {
+    const char *name;
+    size_t offset;
+    bool required;
+} SEglATraceDesc;
+
+static const SEglATraceDesc segl_atrace_descs[] = {
+    { "ATrace_beginSection", offsetof(SEglATrace, beginSection), true },
+    { "ATrace_endSection", offsetof(SEglATrace, endSection), true },
+    { "ATrace_setCounter", offsetof(SEglATrace, setCounter), false },
+};
+
+bool segl_atrace_load(void) {
+    void *so_handle = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (so_handle == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to load libandroid.so: %s",
+            dlerror()
+        );
+        return false;
+    }
+
+    SEglATrace atrace = { 0 };
+    uint32_t missing = 0;
+    for (size_t i = 0; i < countof(segl_atrace_descs); i += 1) {
+        const SEglATraceDesc *desc = &segl_atrace_descs[i];
+        SProc proc = (SProc)dlsym(so_handle, desc->name);
+        memcpy((char *)&atrace + desc->offset, &proc, sizeof(proc));
+        if (proc == NULL && desc->required) {
+            missing += 1;
+        }
+    }
+    if (missing > 0) {
+        SEGL_LOG(
+            ANDROID_LOG_INFO,
+            "no ATrace sections (API 23)"
+        );
+        return false;
+    }
+    segl_atrace = atrace;
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "ATrace sections%s",
+        atrace.setCounter != NULL ? " and counters" : ""
+    );
+    return true;
+}
+
+#else // __ANDROID__
+
+// NOTE: the host stands in for libandroid.so with the lines ATrace writes
+// to the kernel's trace_marker
+
+static void segl_atrace_host_begin(const char *section_name) {
+    printf("B|%d|%s\n", (int)getpid(), section_name);
+}
+
+static void segl_atrace_host_end(void) {
+    printf("E|%d\n", (int)getpid());
+}
+
+static void segl_atrace_host_counter(
+    const char *counter_name,
+    int64_t counter_value
+) {
+    printf(
+        "C|%d|%s|%lld\n",
+        (int)getpid(),
+        counter_name,
+        (long long)counter_value
+    );
+}
+
+bool segl_atrace_load(void) {
+    segl_atrace = (SEglATrace){
+        .beginSection = segl_atrace_host_begin,
+        .endSection = segl_atrace_host_end,
+        .setCounter = segl_atrace_host_counter,
+    };
+    return true;
+}
+
+#endif // __ANDROID__
+
+static void segl_atrace_event(
+    SEglTracePhase phase,
+    const char *name,
+    int64_t value
+) {
+    if (segl_atrace.beginSection == NULL) {
+        return;
+    }
+    switch (phase) {
+        case SEGL_TRACE_PHASE_BEGIN:
+            segl_atrace.beginSection(name);
+            break;
+        case SEGL_TRACE_PHASE_END:
+            segl_atrace.endSection();
+            break;
+        case SEGL_TRACE_PHASE_INSTANT:
+            // NOTE: systrace has no instants, an empty section comes closest
+            segl_atrace.beginSection(name);
+            segl_atrace.endSection();
+            break;
+        case SEGL_TRACE_PHASE_COUNTER:
+            if (segl_atrace.setCounter != NULL) {
+                segl_atrace.setCounter(name, value);
+            }
+            break;
+    }
+}
+
+#endif // SEGL_ATRACE
+
+#ifdef SEGL_TRACE
+
+// NOTE: the fields are relaxed atomics only so that a dump may read a slot
+// the owner is overwriting; it throws such slots away, see segl_trace_dump
+typedef struct {
+    _Atomic int64_t ts_ns;
+    _Atomic(const char *) name;
+    _Atomic int phase;
+    _Atomic int64_t value;
+} SEglTraceSlot;
+
+typedef struct {
+    int64_t ts_ns;
+    const char *name;
+    int phase;
+    int64_t value;
+} SEglTraceEvent;
+
+typedef struct {
+    SEglTraceSlot slots[SEGL_TRACE_RING_LEN];
+    // events ever recorded, published by the owner after each one
+    _Atomic uint64_t head;
+    // set once tid and thread_name are filled in
+    atomic_bool ready;
+    // cleared when the owner exits, so a thread of the same name can
+    // carry on in the ring
+    atomic_bool owned;
+    int tid;
+    char thread_name[16];
+} SEglTraceRing;
+
+static SEglTraceRing segl_trace_rings[SEGL_TRACE_MAX_THREADS];
+static atomic_uint segl_trace_nrings;
+static atomic_ullong segl_trace_dropped;
+static atomic_bool segl_trace_full_logged;
+static pthread_once_t segl_trace_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t segl_trace_key;
+
+static _Thread_local SEglTraceRing *segl_trace_ring;
+static _Thread_local bool segl_trace_unringed;
+
+static const char segl_trace_phases[] = {
+    [SEGL_TRACE_PHASE_BEGIN] = 'B',
+    [SEGL_TRACE_PHASE_END] = 'E',
+    [SEGL_TRACE_PHASE_INSTANT] = 'i',
+    [SEGL_TRACE_PHASE_COUNTER] = 'C',
+};
+
+static void segl_trace_ring_release(void *ring) {
+    atomic_store_explicit(
+        &((SEglTraceRing *)ring)->owned,
+        false,
+        memory_order_release
+    );
+}
+
+static void segl_trace_key_create(void) {
+    pthread_key_create(&segl_trace_key, segl_trace_ring_release);
+}
+
+// Takes the ring a thread of the same name left behind, e.g. a restarted
+// worker, or else a new one.
+static SEglTraceRing *segl_trace_ring_claim(void) {
+    char thread_name[16];
+    if (prctl(PR_GET_NAME, thread_name, 0, 0, 0) != 0) {
+        snprintf(thread_name, sizeof(thread_name), "thread");
+    }
+    // NOTE: thread names are set by whoever spawned the thread, so keep
+    // them to characters that need no escaping in JSON
+    for (char *c = thread_name; *c != '\0'; c += 1) {
+        if (*c == '"' || *c == '\\' || (unsigned char)*c < 0x20) {
+            *c = '_';
+        }
+    }
+    pthread_once(&segl_trace_key_once, segl_trace_key_create);
+
+    // NOTE: a reused ring keeps the first owner's tid, so the restarted
+    // thread continues the same track in the trace
+    SEglTraceRing *ring = NULL;
+    unsigned nrings = atomic_load_explicit(
+        &segl_trace_nrings,
+        memory_order_relaxed
+    );
+    for (unsigned i = 0; i < nrings && i < SEGL_TRACE_MAX_THREADS; i += 1) {
+        SEglTraceRing *candidate = &segl_trace_rings[i];
+        bool owned = false;
+        if (
+            atomic_load_explicit(&candidate->ready, memory_order_acquire) &&
+            strcmp(candidate->thread_name, thread_name) == 0 &&
+            atomic_compare_exchange_strong_explicit(
+                &candidate->owned,
+                &owned,
+                true,
+                memory_order_acquire,
+                memory_order_relaxed
+            )
+        ) {
+            ring = candidate;
+            break;
+        }
+    }
+
+    if (ring == NULL) {
+        unsigned i = atomic_fetch_add_explicit(
+            &segl_trace_nrings,
+            1,
+            memory_order_relaxed
+        );
+        if (i >= SEGL_TRACE_MAX_THREADS) {
+            segl_trace_unringed = true;
+            if (
+                !atomic_exchange_explicit(
+                    &segl_trace_full_logged,
+                    true,
+                    memory_order_relaxed
+                )
+            ) {
+                SEGL_LOG(
+                    ANDROID_LOG_WARN,
+                    "no trace ring left for thread %s, its events are dropped",
+                    thread_name
+                );
+            }
+            return NULL;
+        }
+        ring = &segl_trace_rings[i];
+        ring->tid = (int)syscall(SYS_gettid);
+        memcpy(ring->thread_name, thread_name, sizeof(thread_name));
+        atomic_store_explicit(&ring->owned, true, memory_order_relaxed);
+        atomic_store_explicit(&ring->ready, true, memory_order_release);
+    }
+    pthread_setspecific(segl_trace_key, ring);
+    segl_trace_ring = ring;
+    return ring;
+}
+
+static void segl_trace_record(
+    SEglTracePhase phase,
+    const char *name,
+    int64_t value
+) {
+    SEglTraceRing *ring = segl_trace_ring;
+    if (ring == NULL) {
+        ring = segl_trace_unringed ? NULL : segl_trace_ring_claim();
+        if (ring == NULL) {
+            atomic_fetch_add_explicit(
+                &segl_trace_dropped,
+                1,
+                memory_order_relaxed
+            );
+            return;
+        }
+    }
+
+    TimeSpec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    SEglTraceSlot *slot = &ring->slots[head % SEGL_TRACE_RING_LEN];
+    atomic_store_explicit(
+        &slot->ts_ns,
+        (int64_t)now.tv_sec * 1000000000L + now.tv_nsec,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(&slot->name, name, memory_order_relaxed);
+    atomic_store_explicit(&slot->phase, (int)phase, memory_order_relaxed);
+    atomic_store_explicit(&slot->value, value, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Copies the events of ring still intact after the copy into events and
+// returns how many there are.
+static size_t segl_trace_ring_read(
+    SEglTraceRing *ring,
+    SEglTraceEvent *events
+) {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t tail = head > SEGL_TRACE_RING_LEN ?
+        head - SEGL_TRACE_RING_LEN :
+        0;
+    for (uint64_t i = tail; i < head; i += 1) {
+        SEglTraceSlot *slot = &ring->slots[i % SEGL_TRACE_RING_LEN];
+        SEglTraceEvent *event = &events[i - tail];
+        event->ts_ns = atomic_load_explicit(
+            &slot->ts_ns,
+            memory_order_relaxed
+        );
+        event->name = atomic_load_explicit(&slot->name, memory_order_relaxed);
+        event->phase = atomic_load_explicit(
+            &slot->phase,
+            memory_order_relaxed
+        );
+        event->value = atomic_load_explicit(
+            &slot->value,
+            memory_order_relaxed
+        );
+    }
+
+    // NOTE: the owner kept recording during the copy, and the event it
+    // records at index i lands in the slot of i - SEGL_TRACE_RING_LEN, so
+    // every slot at or below the new head less the ring length is suspect
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t head_after = atomic_load_explicit(
+        &ring->head,
+        memory_order_relaxed
+    );
+    uint64_t valid = head_after >= SEGL_TRACE_RING_LEN ?
+        head_after - SEGL_TRACE_RING_LEN + 1 :
+        0;
+    if (valid <= tail) {
+        return (size_t)(head - tail);
+    }
+    if (valid >= head) {
+        return 0;
+    }
+    size_t skip = (size_t)(valid - tail);
+    for (size_t i = skip; i < head - tail; i += 1) {
+        events[i - skip] = events[i];
+    }
+    return (size_t)(head - valid);
+}
+
+bool segl_trace_dump(const char *path) {
+    TimeSpec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    SEglTraceEvent *events = malloc(
+        SEGL_TRACE_RING_LEN * sizeof(SEglTraceEvent)
+    );
+    FILE *file = events != NULL ? fopen(path, "w") : NULL;
+    if (file == NULL) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to write trace to %s",
+            path
+        );
+        free(events);
+        return false;
+    }
+
+    int pid = (int)getpid();
+    size_t written = 0;
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    unsigned nrings = atomic_load_explicit(
+        &segl_trace_nrings,
+        memory_order_relaxed
+    );
+    if (nrings > SEGL_TRACE_MAX_THREADS) {
+        nrings = SEGL_TRACE_MAX_THREADS;
+    }
+    for (unsigned r = 0; r < nrings; r += 1) {
+        SEglTraceRing *ring = &segl_trace_rings[r];
+        if (!atomic_load_explicit(&ring->ready, memory_order_acquire)) {
+            continue;
+        }
+        fprintf(
+            file,
+            "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",",
+            pid,
+            ring->tid,
+            ring->thread_name
+        );
+        first = false;
+
+        size_t nevents = segl_trace_ring_read(ring, events);
+        for (size_t i = 0; i < nevents; i += 1) {
+            const SEglTraceEvent *event = &events[i];
+            // NOTE: Chrome trace timestamps are in microseconds, the
+            // fraction keeps the nanoseconds
+            fprintf(
+                file,
+                ",\n{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%lld.%03lld,"
+                "\"pid\":%d,\"tid\":%d",
+                event->name,
+                segl_trace_phases[event->phase],
+                event->phase == SEGL_TRACE_PHASE_INSTANT ?
+                    "\"s\":\"t\"," :
+                    "",
+                (long long)(event->ts_ns / 1000),
+                (long long)(event->ts_ns % 1000),
+                pid,
+                ring->tid
+            );
+            if (event->phase == SEGL_TRACE_PHASE_COUNTER) {
+                fprintf(
+                    file,
+                    ",\"args\":{\"value\":%lld}",
+                    (long long)event->value
+                );
+            }
+            fputc('}', file);
+        }
+        written += nevents;
+    }
+    fprintf(file, "\n]}\n");
+    free(events);
+    bool ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+
+    TimeSpec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    SEGL_LOG(
+        ok ? ANDROID_LOG_INFO : ANDROID_LOG_WARN,
+        "%s %zu trace events of %u threads to %s in %lld ns "
+        "(%llu dropped)",
+        ok ? "wrote" : "failed to write",
+        written,
+        nrings,
+        path,
+        (long long)time_since(end, start),
+        (unsigned long long)atomic_load_explicit(
+            &segl_trace_dropped,
+            memory_order_relaxed
+        )
+    );
+    return ok;
+}
+
+#endif // SEGL_TRACE
+
+void segl_trace_event(SEglTracePhase phase, const char *name, int64_t value) {
+#ifdef SEGL_TRACE
+    segl_trace_record(phase, name, value);
+#endif
+#ifdef SEGL_ATRACE
+    segl_atrace_event(phase, name, value);
+#endif
+}
+
+#endif // SEGL_TRACING
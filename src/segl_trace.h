@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_TRACE_H
+#define SEGL_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Begin/end/instant/counter events, sent to up to two backends chosen at
+// build time; with neither the SEGL_TRACE_* macros expand to nothing and
+// none of this is compiled.
+//
+// -DSEGL_TRACE records into a ring of the last SEGL_TRACE_RING_LEN events
+// per thread without locks, and segl_trace_dump writes all rings as
+// Chrome trace JSON for chrome://tracing or Perfetto.
+//
+// -DSEGL_ATRACE turns begin/end into ATrace sections and counters into
+// ATrace counters for systrace and Perfetto on the device, once
+// segl_atrace_load has found them in libandroid.so. Host builds write the
+// same trace_marker lines to stdout instead.
+//
+// NOTE: event names are kept by pointer and written to JSON as is, so
+// they must be string literals (or live as long) and need no escaping
+
+#define SEGL_TRACE_RING_LEN 8192
+// rings for this many threads; a thread reuses the ring an exited thread
+// of the same name left, and threads past that record nothing and count
+// their events as dropped
+#define SEGL_TRACE_MAX_THREADS 8
+
+typedef enum {
+    SEGL_TRACE_PHASE_BEGIN,
+    SEGL_TRACE_PHASE_END,
+    SEGL_TRACE_PHASE_INSTANT,
+    SEGL_TRACE_PHASE_COUNTER,
+} SEglTracePhase;
+
+#if defined(SEGL_TRACE) || defined(SEGL_ATRACE)
+#define SEGL_TRACING
+#endif
+
+#ifdef SEGL_TRACING
+
+// value is only kept for counters
+void segl_trace_event(SEglTracePhase phase, const char *name, int64_t value);
+
+#define SEGL_TRACE_BEGIN(name) \
+    segl_trace_event(SEGL_TRACE_PHASE_BEGIN, (name), 0)
+#define SEGL_TRACE_END(name) segl_trace_event(SEGL_TRACE_PHASE_END, (name), 0)
+#define SEGL_TRACE_INSTANT(name) \
+    segl_trace_event(SEGL_TRACE_PHASE_INSTANT, (name), 0)
+#define SEGL_TRACE_COUNTER(name, value) \
+    segl_trace_event(SEGL_TRACE_PHASE_COUNTER, (name), (value))
+
+#else // SEGL_TRACING
+
+#define SEGL_TRACE_BEGIN(name) ((void)0)
+#define SEGL_TRACE_END(name) ((void)0)
+#define SEGL_TRACE_INSTANT(name) ((void)0)
+#define SEGL_TRACE_COUNTER(name, value) ((void)0)
+
+#endif // SEGL_TRACING
+
+#ifdef SEGL_TRACE
+
+// Writes the events of all threads to path. Safe to call from any thread
+// while the others keep recording; returns false if the file could not be
+// written.
+bool segl_trace_dump(const char *path);
+
+#define SEGL_TRACE_DUMP(path) segl_trace_dump(path)
+
+#else // SEGL_TRACE
+
+#define SEGL_TRACE_DUMP(path) ((void)0)
+
+#endif // SEGL_TRACE
+
+#ifdef SEGL_ATRACE
+
+// ATrace_beginSection and ATrace_endSection exist from API 23 on and
+// ATrace_setCounter from API 29 on, so they are looked up at runtime to
+// keep the app loading on API 22; events before this, or on a device
+// without them, skip ATrace. Call it before starting other threads.
+// Returns false when there are no ATrace sections.
+bool segl_atrace_load(void);
+
+#define SEGL_ATRACE_LOAD() segl_atrace_load()
+
+#else // SEGL_ATRACE
+
+#define SEGL_ATRACE_LOAD() ((void)0)
+
+#endif // SEGL_ATRACE
+
+#endif // SEGL_TRACE_H
@@ -0,0 +1,329 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <pthread.h>
+#include <sys/prctl.h>
+
+#include "segl.h"
+#include "segl_log.h"
+#include "segl_trace.h"
+#include "segl_upload.h"
+
+static void segl_upload_queue_push(
+    SEglUploadQueue *queue,
+    const SEglUploadJob *job
+) {
+    size_t tail = (queue->head + queue->len) % SEGL_UPLOAD_QUEUE_LEN;
+    queue->jobs[tail] = *job;
+    queue->len += 1;
+}
+
+static SEglUploadJob segl_upload_queue_pop(SEglUploadQueue *queue) {
+    SEglUploadJob job = queue->jobs[queue->head];
+    queue->head = (queue->head + 1) % SEGL_UPLOAD_QUEUE_LEN;
+    queue->len -= 1;
+    return job;
+}
+
+static bool segl_upload_fenced(const SEglUploader *uploader) {
+    return (uploader->ext->caps & SEGL_CAP(EGL_KHR_FENCE_SYNC)) != 0;
+}
+
+static void *segl_upload_thread(void *arg) {
+    prctl(PR_SET_NAME, "segl_upload", 0, 0, 0);
+    SEglUploader *uploader = arg;
+    const SEglVtable *segl_vtable = uploader->segl_vtable;
+    const SGlVtable *sgl_vtable = uploader->sgl_vtable;
+
+    bool current = segl_vtable->MakeCurrent(
+        uploader->display,
+        uploader->surface,
+        uploader->surface,
+        uploader->context
+    );
+
+    pthread_mutex_lock(&uploader->mutex);
+    if (!current) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to make upload context current: 0x%x",
+            segl_vtable->GetError()
+        );
+        uploader->running = false;
+    }
+    while (uploader->running && !uploader->quit) {
+        if (uploader->pending.len == 0) {
+            pthread_cond_wait(&uploader->cond, &uploader->mutex);
+            continue;
+        }
+        SEglUploadJob job = segl_upload_queue_pop(&uploader->pending);
+        pthread_mutex_unlock(&uploader->mutex);
+
+        SEGL_TRACE_BEGIN("upload");
+        job.upload(sgl_vtable, job.userdata);
+        job.fence = EGL_NO_SYNC_KHR;
+        if (segl_upload_fenced(uploader)) {
+            job.fence = uploader->ext->CreateSyncKHR(
+                uploader->display,
+                EGL_SYNC_FENCE_KHR,
+                NULL
+            );
+        }
+        // NOTE: a fence only signals once the commands before it reach the
+        // GPU, and the render thread cannot flush this context for us
+        if (job.fence != EGL_NO_SYNC_KHR) {
+            sgl_vtable->Flush();
+        } else {
+            sgl_vtable->Finish();
+        }
+
+        SEGL_TRACE_END("upload");
+
+        pthread_mutex_lock(&uploader->mutex);
+        segl_upload_queue_push(&uploader->finished, &job);
+    }
+    pthread_mutex_unlock(&uploader->mutex);
+
+    segl_vtable->MakeCurrent(
+        uploader->display,
+        EGL_NO_SURFACE,
+        EGL_NO_SURFACE,
+        EGL_NO_CONTEXT
+    );
+    return NULL;
+}
+
+bool segl_upload_start(
+    SEglUploader *uploader,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    const SEglExt *ext
+) {
+    *uploader = (SEglUploader){
+        .segl_vtable = segl_vtable,
+        .sgl_vtable = sgl_vtable,
+        .ext = ext,
+        .display = segl_ctx->display,
+        .context = EGL_NO_CONTEXT,
+        .surface = EGL_NO_SURFACE,
+    };
+
+    if ((segl_ctx->attribs.surface_type & EGL_PBUFFER_BIT) == 0) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "config %d has no pbuffer support, uploads disabled",
+            segl_ctx->attribs.config_id
+        );
+        return false;
+    }
+
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION,
+        2,
+        EGL_CONTEXT_MINOR_VERSION,
+        0,
+        EGL_NONE,
+    };
+    uploader->context = segl_vtable->CreateContext(
+        segl_ctx->display,
+        segl_ctx->config,
+        segl_ctx->context,
+        context_attribs
+    );
+    if (uploader->context == EGL_NO_CONTEXT) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to create shared upload context: 0x%x",
+            segl_vtable->GetError()
+        );
+        return false;
+    }
+
+    const EGLint pbuffer_attribs[] = {
+        EGL_WIDTH,
+        1,
+        EGL_HEIGHT,
+        1,
+        EGL_NONE,
+    };
+    uploader->surface = segl_vtable->CreatePbufferSurface(
+        segl_ctx->display,
+        segl_ctx->config,
+        pbuffer_attribs
+    );
+    if (uploader->surface == EGL_NO_SURFACE) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to create upload pbuffer: 0x%x",
+            segl_vtable->GetError()
+        );
+        segl_vtable->DestroyContext(segl_ctx->display, uploader->context);
+        uploader->context = EGL_NO_CONTEXT;
+        return false;
+    }
+
+    pthread_mutex_init(&uploader->mutex, NULL);
+    pthread_cond_init(&uploader->cond, NULL);
+    uploader->running = true;
+    if (
+        pthread_create(
+            &uploader->thread,
+            NULL,
+            segl_upload_thread,
+            uploader
+        ) != 0
+    ) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "failed to start upload thread"
+        );
+        uploader->running = false;
+        pthread_cond_destroy(&uploader->cond);
+        pthread_mutex_destroy(&uploader->mutex);
+        segl_vtable->DestroySurface(segl_ctx->display, uploader->surface);
+        segl_vtable->DestroyContext(segl_ctx->display, uploader->context);
+        uploader->surface = EGL_NO_SURFACE;
+        uploader->context = EGL_NO_CONTEXT;
+        return false;
+    }
+
+    SEGL_LOG(
+        ANDROID_LOG_INFO,
+        "upload thread started (%s)",
+        segl_upload_fenced(uploader) ? "fence sync" : "glFinish"
+    );
+    return true;
+}
+
+void segl_upload_stop(SEglUploader *uploader) {
+    if (uploader->context == EGL_NO_CONTEXT) {
+        return;
+    }
+
+    pthread_mutex_lock(&uploader->mutex);
+    uploader->quit = true;
+    pthread_cond_signal(&uploader->cond);
+    pthread_mutex_unlock(&uploader->mutex);
+    pthread_join(uploader->thread, NULL);
+
+    size_t dropped = uploader->inflight;
+    while (uploader->finished.len > 0) {
+        SEglUploadJob job = segl_upload_queue_pop(&uploader->finished);
+        if (job.fence != EGL_NO_SYNC_KHR) {
+            uploader->ext->DestroySyncKHR(uploader->display, job.fence);
+        }
+    }
+    if (dropped > 0) {
+        SEGL_LOG(
+            ANDROID_LOG_WARN,
+            "dropped %zu unfinished uploads",
+            dropped
+        );
+    }
+
+    pthread_cond_destroy(&uploader->cond);
+    pthread_mutex_destroy(&uploader->mutex);
+    uploader->segl_vtable->DestroySurface(
+        uploader->display,
+        uploader->surface
+    );
+    uploader->segl_vtable->DestroyContext(
+        uploader->display,
+        uploader->context
+    );
+    uploader->surface = EGL_NO_SURFACE;
+    uploader->context = EGL_NO_CONTEXT;
+    uploader->running = false;
+    uploader->inflight = 0;
+    uploader->pending.len = 0;
+}
+
+bool segl_upload_submit(
+    SEglUploader *uploader,
+    SEglUploadFn upload,
+    SEglUploadDoneFn done,
+    void *userdata
+) {
+    if (uploader->context == EGL_NO_CONTEXT) {
+        return false;
+    }
+
+    SEglUploadJob job = {
+        .upload = upload,
+        .done = done,
+        .userdata = userdata,
+        .fence = EGL_NO_SYNC_KHR,
+    };
+
+    pthread_mutex_lock(&uploader->mutex);
+    bool accepted = (
+        uploader->running &&
+        uploader->inflight < SEGL_UPLOAD_QUEUE_LEN
+    );
+    if (accepted) {
+        segl_upload_queue_push(&uploader->pending, &job);
+        uploader->inflight += 1;
+        pthread_cond_signal(&uploader->cond);
+    }
+    pthread_mutex_unlock(&uploader->mutex);
+    return accepted;
+}
+
+size_t segl_upload_poll(SEglUploader *uploader, size_t max_jobs) {
+    if (uploader->context == EGL_NO_CONTEXT) {
+        return 0;
+    }
+
+    size_t handed = 0;
+    while (handed < max_jobs) {
+        // NOTE: only this thread pops finished jobs, so the head stays put
+        // while the lock is released
+        pthread_mutex_lock(&uploader->mutex);
+        bool empty = uploader->finished.len == 0;
+        SEglUploadJob job = uploader->finished.jobs[uploader->finished.head];
+        pthread_mutex_unlock(&uploader->mutex);
+        if (empty) {
+            break;
+        }
+
+        if (job.fence != EGL_NO_SYNC_KHR) {
+            EGLint status = uploader->ext->ClientWaitSyncKHR(
+                uploader->display,
+                job.fence,
+                0,
+                0
+            );
+            if (status == EGL_TIMEOUT_EXPIRED_KHR) {
+                break;
+            }
+            uploader->ext->DestroySyncKHR(uploader->display, job.fence);
+        }
+
+        pthread_mutex_lock(&uploader->mutex);
+        segl_upload_queue_pop(&uploader->finished);
+        uploader->inflight -= 1;
+        pthread_mutex_unlock(&uploader->mutex);
+
+        if (job.done != NULL) {
+            job.done(job.userdata);
+        }
+        handed += 1;
+    }
+    return handed;
+}
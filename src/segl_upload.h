@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Daniel Aven Bross
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SEGL_UPLOAD_H
+#define SEGL_UPLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <pthread.h>
+
+#include "segl.h"
+
+// Maximum number of jobs submitted but not yet handed back.
+#define SEGL_UPLOAD_QUEUE_LEN 64
+
+// Runs on the upload thread with the shared context current.
+typedef void (*SEglUploadFn)(const SGlVtable *sgl_vtable, void *userdata);
+// Runs on the render thread inside segl_upload_poll, once the GPU has
+// finished the commands issued by the matching SEglUploadFn.
+typedef void (*SEglUploadDoneFn)(void *userdata);
+
+typedef struct {
+    SEglUploadFn upload;
+    SEglUploadDoneFn done;
+    void *userdata;
+    EGLSyncKHR fence;
+} SEglUploadJob;
+
+typedef struct {
+    size_t head;
+    size_t len;
+    SEglUploadJob jobs[SEGL_UPLOAD_QUEUE_LEN];
+} SEglUploadQueue;
+
+// A worker thread owning a second context that shares objects with the
+// render context, bound to a 1x1 pbuffer. With EGL_KHR_fence_sync each
+// upload is followed by a fence that the render thread polls without
+// blocking; without it the worker calls glFinish before handing over.
+typedef struct {
+    const SEglVtable *segl_vtable;
+    const SGlVtable *sgl_vtable;
+    const SEglExt *ext;
+    EGLDisplay display;
+    EGLContext context;
+    EGLSurface surface;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool running;
+    bool quit;
+    // submitted jobs not yet handed back, bounds both queues
+    size_t inflight;
+    // written by the render thread, read by the worker
+    SEglUploadQueue pending;
+    // written by the worker, read by the render thread
+    SEglUploadQueue finished;
+} SEglUploader;
+
+// Needs a config with EGL_PBUFFER_BIT. Returns false, logging why, when the
+// context, pbuffer or thread cannot be created.
+bool segl_upload_start(
+    SEglUploader *uploader,
+    const SEglCtx *segl_ctx,
+    const SEglVtable *segl_vtable,
+    const SGlVtable *sgl_vtable,
+    const SEglExt *ext
+);
+// Joins the worker and destroys its context. Jobs that were not handed
+// back yet are dropped without calling their done callback. Must run
+// before the render context is destroyed; does nothing if not started.
+void segl_upload_stop(SEglUploader *uploader);
+
+// Returns false when the uploader is not running or SEGL_UPLOAD_QUEUE_LEN
+// jobs are already in flight.
+bool segl_upload_submit(
+    SEglUploader *uploader,
+    SEglUploadFn upload,
+    SEglUploadDoneFn done,
+    void *userdata
+);
+// Hands back at most max_jobs finished uploads in submission order, calling
+// their done callbacks. Never blocks on the GPU. Returns the number handed
+// back.
+size_t segl_upload_poll(SEglUploader *uploader, size_t max_jobs);
+
+#endif // SEGL_UPLOAD_H